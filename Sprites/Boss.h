@@ -1,63 +0,0 @@
-/* Boss.h
- * generated by png2gba program */
-
-#define Boss_width 16
-#define Boss_height 16
-
-const unsigned char Boss_data [] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x04, 
-    0x00, 0x00, 0x00, 0x00, 0x02, 0x05, 0x06, 0x07, 0x00, 0x00, 0x00, 0x00, 
-    0x08, 0x09, 0x0A, 0x0B, 0x00, 0x00, 0x00, 0x00, 0x08, 0x0C, 0x0D, 0x0E, 
-    0x00, 0x00, 0x0F, 0x10, 0x08, 0x11, 0x12, 0x0E, 0x00, 0x00, 0x13, 0x14, 
-    0x15, 0x16, 0x11, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x19, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x1A, 0x1B, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x1C, 0x09, 0x1D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1E, 0x1F, 0x1D, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x20, 0x21, 0x1D, 0x0F, 0x10, 0x00, 0x00, 0x00, 
-    0x21, 0x22, 0x23, 0x24, 0x25, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x09, 
-    0x26, 0x27, 0x28, 0x29, 0x00, 0x00, 0x08, 0x09, 0x2A, 0x2B, 0x2C, 0x17, 
-    0x00, 0x00, 0x08, 0x09, 0x2D, 0x2E, 0x2F, 0x09, 0x00, 0x00, 0x30, 0x31, 
-    0x32, 0x33, 0x34, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x35, 0x36, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x37, 0x38, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x39, 0x3A, 0x3B, 0x09, 0x1D, 0x00, 0x00, 0x00, 0x3C, 0x3D, 0x2F, 0x09, 
-    0x1D, 0x00, 0x00, 0x00, 0x2A, 0x3E, 0x34, 0x09, 0x1D, 0x00, 0x00, 0x00, 
-    0x2D, 0x3F, 0x30, 0x31, 0x32, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 
-};
-
-const unsigned short Boss_palette [] = {
-    0x7c1f, 0x0000, 0x0400, 0x0c21, 0x0c63, 0x3080, 0x7e2a, 0x7fff, 0x2860, 
-    0x7d40, 0x760a, 0x6f7f, 0x7521, 0x48cc, 0x001f, 0x0421, 0x0842, 0x54e9, 
-    0x081c, 0x2929, 0x5672, 0x2c60, 0x7120, 0x0c3b, 0x0c42, 0x0800, 0x7f14, 
-    0x54e0, 0x72b4, 0x50c0, 0x2475, 0x7122, 0x041d, 0x3092, 0x7520, 0x4cc0, 
-    0x3149, 0x5272, 0x50c1, 0x2462, 0x6d21, 0x6d23, 0x50ca, 0x0015, 0x040b, 
-    0x50c9, 0x001c, 0x2874, 0x2460, 0x6d20, 0x48c0, 0x0009, 0x2872, 0x2881, 
-    0x7d83, 0x2529, 0x6f7b, 0x6d22, 0x48c1, 0x2862, 0x0813, 0x000c, 0x001d, 
-    0x0012, 0x5102, 0x4a52, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000
-};
-
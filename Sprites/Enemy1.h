@@ -1,63 +0,0 @@
-/* Enemy1.h
- * generated by png2gba program */
-
-#define Enemy1_width 16
-#define Enemy1_height 16
-
-const unsigned char Enemy1_data [] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x04, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x07, 
-    0x00, 0x00, 0x00, 0x00, 0x02, 0x08, 0x09, 0x0A, 0x00, 0x00, 0x00, 0x02, 
-    0x0B, 0x0C, 0x0D, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x0F, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x10, 0x11, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x13, 0x14, 0x15, 0x00, 0x00, 0x00, 0x00, 0x00, 0x16, 0x17, 0x0F, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x18, 0x19, 0x1A, 0x08, 0x0F, 0x00, 0x00, 0x00, 
-    0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 
-    0x21, 0x22, 0x23, 0x24, 0x00, 0x00, 0x00, 0x20, 0x25, 0x26, 0x23, 0x00, 
-    0x00, 0x00, 0x00, 0x27, 0x28, 0x29, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x27, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x2A, 0x2B, 0x20, 0x21, 0x22, 0x23, 0x00, 0x00, 0x00, 0x00, 0x20, 0x25, 
-    0x26, 0x23, 0x00, 0x00, 0x00, 0x00, 0x27, 0x28, 0x29, 0x08, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x27, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 
-};
-
-const unsigned short Enemy1_palette [] = {
-    0x7c1f, 0x0000, 0x0860, 0x0065, 0x1149, 0x00eb, 0x0935, 0x15e5, 0x0cc0, 
-    0x1dc0, 0x12f1, 0x15a5, 0x2664, 0x2600, 0x0db1, 0x0440, 0x1da9, 0x0d29, 
-    0x0044, 0x0cd5, 0x0555, 0x00a9, 0x1ec9, 0x15a4, 0x033f, 0x1acd, 0x1980, 
-    0x009f, 0x11ad, 0x2620, 0x2665, 0x1584, 0x1960, 0x1211, 0x1a0d, 0x1100, 
-    0x000b, 0x1111, 0x196d, 0x10e0, 0x152b, 0x1549, 0x0015, 0x0009, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000
-};
-
@@ -1,340 +0,0 @@
-/* FullMerged.h
- * generated by png2gba program */
-
-#define Merged_width 16
-#define Merged_height 224
-
-const unsigned char Merged_data [] = {
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x04, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x04, 0x06, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x04, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x08, 0x06, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 
-    0x09, 0x04, 0x06, 0x0A, 0x00, 0x00, 0x00, 0x0B, 0x0B, 0x04, 0x06, 0x06, 
-    0x00, 0x00, 0x00, 0x0B, 0x06, 0x06, 0x06, 0x06, 0x00, 0x00, 0x00, 0x0C, 
-    0x06, 0x06, 0x0D, 0x0E, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x0F, 0x10, 0x11, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x0A, 0x06, 0x04, 0x09, 0x05, 0x00, 0x00, 0x00, 0x06, 0x06, 0x04, 0x0B, 
-    0x0B, 0x00, 0x00, 0x00, 0x06, 0x06, 0x08, 0x06, 0x03, 0x00, 0x00, 0x00, 
-    0x0E, 0x0D, 0x06, 0x06, 0x0C, 0x00, 0x00, 0x00, 0x0C, 0x12, 0x00, 0x0C, 
-    0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x13, 0x00, 0x14, 0x15, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x16, 0x16, 0x15, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x16, 0x16, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x19, 0x17, 
-    0x00, 0x00, 0x1A, 0x1B, 0x00, 0x16, 0x18, 0x17, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x15, 0x14, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x15, 0x16, 0x16, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x17, 0x16, 0x16, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x17, 0x18, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x17, 0x18, 0x16, 0x00, 0x1B, 0x1A, 0x00, 0x00, 
-    0x00, 0x00, 0x18, 0x16, 0x18, 0x1D, 0x1E, 0x1F, 0x00, 0x00, 0x18, 0x16, 
-    0x18, 0x20, 0x09, 0x21, 0x00, 0x00, 0x18, 0x16, 0x18, 0x22, 0x23, 0x16, 
-    0x00, 0x00, 0x18, 0x16, 0x18, 0x09, 0x22, 0x16, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x15, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x24, 0x16, 0x25, 0x18, 0x16, 0x18, 0x00, 0x00, 
-    0x21, 0x09, 0x20, 0x18, 0x16, 0x18, 0x00, 0x00, 0x14, 0x23, 0x22, 0x18, 
-    0x16, 0x18, 0x00, 0x00, 0x14, 0x22, 0x09, 0x18, 0x16, 0x18, 0x00, 0x00, 
-    0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1B, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x26, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x27, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x26, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x26, 0x26, 0x28, 0x00, 0x00, 0x00, 0x00, 0x26, 0x29, 0x2A, 0x2B, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x26, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x2C, 0x26, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x17, 0x27, 0x21, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x2D, 0x26, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x2E, 0x2F, 0x26, 0x26, 0x00, 0x00, 0x00, 0x00, 0x30, 0x31, 0x2A, 0x32, 
-    0x26, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x26, 0x33, 0x34, 0x35, 0x36, 
-    0x00, 0x00, 0x00, 0x26, 0x37, 0x37, 0x35, 0x00, 0x00, 0x00, 0x00, 0x26, 
-    0x26, 0x26, 0x26, 0x00, 0x00, 0x00, 0x00, 0x00, 0x26, 0x26, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x09, 0x35, 0x34, 
-    0x33, 0x26, 0x00, 0x00, 0x00, 0x00, 0x35, 0x37, 0x37, 0x26, 0x00, 0x00, 
-    0x00, 0x00, 0x26, 0x26, 0x26, 0x26, 0x00, 0x00, 0x00, 0x00, 0x00, 0x26, 
-    0x26, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x38, 0x00, 0x39, 0x00, 0x00, 0x00, 0x38, 0x38, 0x38, 0x00, 0x15, 
-    0x00, 0x00, 0x00, 0x12, 0x38, 0x38, 0x3A, 0x15, 0x00, 0x00, 0x00, 0x00, 
-    0x12, 0x38, 0x17, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x39, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 0x15, 0x00, 0x38, 0x38, 
-    0x38, 0x00, 0x00, 0x00, 0x15, 0x38, 0x38, 0x38, 0x00, 0x00, 0x00, 0x00, 
-    0x3B, 0x38, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 
-    0x38, 0x38, 0x17, 0x15, 0x00, 0x00, 0x00, 0x12, 0x38, 0x38, 0x00, 0x39, 
-    0x00, 0x00, 0x00, 0x00, 0x12, 0x38, 0x00, 0x13, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x15, 0x38, 0x38, 0x3A, 0x3A, 0x00, 0x00, 0x00, 0x39, 0x00, 0x38, 0x17, 
-    0x00, 0x00, 0x00, 0x00, 0x13, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x12, 0x00, 0x00, 0x3C, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x12, 0x00, 0x00, 0x3C, 0x3C, 
-    0x3C, 0x3C, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x12, 0x00, 0x3C, 
-    0x3C, 0x10, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x00, 0x3C, 0x10, 0x00, 0x00, 
-    0x00, 0x00, 0x3C, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x00, 
-    0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x12, 0x00, 0x3C, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x3D, 0x00, 0x00, 0x00, 0x3C, 0x3C, 0x00, 0x00, 
-    0x3C, 0x3C, 0x3C, 0x3C, 0x00, 0x00, 0x3C, 0x10, 0x3C, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x3C, 0x10, 0x3C, 0x3C, 0x3C, 0x3C, 0x00, 0x00, 0x3C, 0x12, 
-    0x3C, 0x10, 0x00, 0x00, 0x3C, 0x3C, 0x00, 0x00, 0x3C, 0x12, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x3C, 0x12, 0x3C, 0x12, 0x3C, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x3C, 0x3C, 0x3C, 0x12, 0x00, 
-    0x3C, 0x10, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x12, 0x3C, 0x3C, 
-    0x3C, 0x3C, 0x3C, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x04, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x3E, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3E, 
-    0x3E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x17, 0x3F, 0x3F, 0x17, 0x00, 0x00, 
-    0x00, 0x00, 0x17, 0x40, 0x40, 0x17, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 
-    0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 
-    0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x41, 0x41, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x41, 0x41, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x16, 
-    0x16, 0x42, 0x00, 0x00, 0x00, 0x00, 0x42, 0x16, 0x16, 0x42, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x42, 0x42, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x43, 0x00, 0x44, 0x44, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x44, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 
-    0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x44, 0x00, 0x00, 
-    0x00, 0x00, 0x44, 0x00, 0x43, 0x44, 0x00, 0x00, 0x00, 0x00, 0x43, 0x44, 
-    0x45, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 
-    0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x47, 0x43, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x47, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 
-    0x00, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x47, 0x44, 0x47, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 
-    0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x43, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x44, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 
-    0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x44, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x44, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x44, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 
-    0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x44, 0x00, 0x00, 
-    0x00, 0x00, 0x44, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 
-    0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x45, 0x45, 
-    0x45, 0x45, 0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x45, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x45, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 
-    0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x44, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x44, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 
-    0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x44, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 
-    0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x44, 0x44, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 
-    0x44, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x48, 0x00, 0x00, 0x00, 0x00, 
-    0x12, 0x10, 0x49, 0x4A, 0x00, 0x00, 0x00, 0x00, 0x4B, 0x23, 0x4C, 0x48, 
-    0x00, 0x00, 0x00, 0x00, 0x0F, 0x0F, 0x4D, 0x4E, 0x00, 0x00, 0x00, 0x00, 
-    0x4C, 0x48, 0x4F, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4C, 0x51, 0x52, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x0F, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4C, 0x48, 0x48, 0x0F, 
-    0x00, 0x00, 0x00, 0x00, 0x53, 0x4C, 0x4C, 0x48, 0x0F, 0x00, 0x00, 0x00, 
-    0x54, 0x55, 0x56, 0x4C, 0x48, 0x00, 0x00, 0x00, 0x57, 0x58, 0x59, 0x48, 
-    0x5A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x12, 0x10, 0x5B, 0x5C, 
-    0x00, 0x00, 0x00, 0x00, 0x4B, 0x23, 0x5D, 0x5E, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x4C, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x5F, 0x23, 0x60, 
-    0x61, 0x00, 0x00, 0x00, 0x62, 0x48, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x4D, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x48, 0x63, 0x0F, 0x48, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x48, 0x64, 0x65, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x0F, 
-    0x00, 0x0F, 0x00, 0x48, 0x66, 0x00, 0x48, 0x66, 0x48, 0x66, 0x00, 0x00, 
-    0x00, 0x00, 0x0F, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x48, 0x66, 0x00, 
-    0x66, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x5A, 0x00, 0x00, 0x48, 0x66, 0x00, 
-    0x00, 0x48, 0x67, 0x00, 0x67, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x66, 0x00, 
-    0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x68, 0x12, 0x12, 0x00, 
-    0x00, 0x00, 0x12, 0x00, 0x48, 0x3A, 0x65, 0x00, 0x00, 0x48, 0x65, 0x00, 
-    0x12, 0x00, 0x00, 0x48, 0x00, 0x00, 0x00, 0x48, 0x65, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5A, 0x5A, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x69, 0x67, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x65, 
-    0x00, 0x0F, 0x00, 0x0F, 0x48, 0x66, 0x00, 0x00, 0x48, 0x6A, 0x48, 0x66, 
-    0x00, 0x00, 0x12, 0x00, 0x48, 0x69, 0x67, 0x00, 0x00, 0x48, 0x65, 0x00, 
-    0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x48, 0x66, 0x00, 
-    0x00, 0x00, 0x00, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x6B, 
-    0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3A, 0x65, 0x00, 0x0F, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x5A, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x67, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x6C, 0x6D, 0x09, 0x00, 0x00, 0x00, 0x00, 
-    0x6C, 0x6D, 0x36, 0x00, 0x00, 0x00, 0x00, 0x05, 0x6E, 0x48, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x6F, 0x43, 0x70, 0x71, 0x48, 0x00, 0x00, 0x00, 0x6F, 
-    0x00, 0x72, 0x48, 0x00, 0x00, 0x00, 0x05, 0x38, 0x73, 0x00, 0x00, 0x00, 
-    0x05, 0x09, 0x6F, 0x17, 0x74, 0x09, 0x00, 0x00, 0x6F, 0x75, 0x6F, 0x17, 
-    0x10, 0x00, 0x05, 0x09, 0x6F, 0x75, 0x6F, 0x17, 0x00, 0x00, 0x00, 0x00, 
-    0x00, 0x43, 0x70, 0x48, 0x09, 0x00, 0x00, 0x00, 0x6C, 0x76, 0x48, 0x00, 
-    0x75, 0x00, 0x00, 0x00, 0x6E, 0x48, 0x00, 0x00, 0x75, 0x00, 0x00, 0x00, 
-    0x00, 0x00, 0x00, 0x3E, 0x3A, 0x09, 0x00, 0x00, 0x00, 0x00, 0x05, 0x77, 
-    0x17, 0x75, 0x05, 0x09, 0x00, 0x00, 0x12, 0x00, 0x17, 0x75, 0x6F, 0x75, 
-    0x00, 0x00, 0x00, 0x6C, 0x17, 0x75, 0x6F, 0x75, 0x05, 0x09, 0x00, 0x6E, 
-    0x73, 0x00, 0x6F, 0x75, 0x6F, 0x3A, 0x38, 0x17, 0x00, 0x00, 0x6F, 0x3A, 
-    0x38, 0x17, 0x17, 0x17, 0x78, 0x00, 0x6F, 0x17, 0x17, 0x17, 0x17, 0x17, 
-    0x74, 0x09, 0x6F, 0x40, 0x10, 0x20, 0x40, 0x20, 0x79, 0x7A, 0x7B, 0x75, 
-    0x00, 0x12, 0x00, 0x6F, 0x7C, 0x7D, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x12, 
-    0x0F, 0x7F, 0x80, 0x05, 0x09, 0x00, 0x00, 0x05, 0x00, 0x6E, 0x81, 0x12, 
-    0x82, 0x83, 0x78, 0x7A, 0x17, 0x3A, 0x38, 0x75, 0x6F, 0x75, 0x00, 0x43, 
-    0x17, 0x17, 0x17, 0x3A, 0x38, 0x75, 0x00, 0x6C, 0x17, 0x17, 0x17, 0x17, 
-    0x17, 0x75, 0x00, 0x43, 0x40, 0x20, 0x40, 0x10, 0x20, 0x75, 0x00, 0x00, 
-    0x75, 0x12, 0x00, 0x00, 0x6F, 0x75, 0x05, 0x84, 0x00, 0x00, 0x00, 0x00, 
-    0x12, 0x00, 0x6F, 0x77, 0x09, 0x6C, 0x78, 0x00, 0x05, 0x09, 0x12, 0x00, 
-    0x85, 0x72, 0x86, 0x6C, 0x85, 0x7A, 0x78, 0x00, 0x00, 0x6C, 0x87, 0x6C, 
-    0x88, 0x89, 0x8A, 0x8B, 0x12, 0x00, 0x8C, 0x8A, 0x6E, 0x88, 0x8D, 0x8E, 
-    0x8F, 0x8A, 0x8B, 0x8D, 0x90, 0x91, 0x92, 0x93, 0x8B, 0x94, 0x88, 0x8E, 
-    0x95, 0x07, 0x15, 0x96, 0x94, 0x81, 0x8B, 0x97, 0x98, 0x99, 0x96, 0x04, 
-    0x81, 0x6E, 0x88, 0x9A, 0x9B, 0x66, 0x00, 0x9C, 0x6E, 0x81, 0x8B, 0x8E, 
-    0x9D, 0x03, 0x00, 0x9C, 0x89, 0x6E, 0x88, 0x97, 0x15, 0x15, 0x48, 0x3E, 
-    0x9E, 0x9F, 0x94, 0x81, 0x8A, 0x8A, 0x43, 0x00, 0xA0, 0x8B, 0x89, 0x8B, 
-    0x8D, 0x8D, 0x89, 0x43, 0xA1, 0x92, 0x92, 0x92, 0xA2, 0x94, 0x88, 0x9E, 
-    0x07, 0x96, 0x07, 0x15, 0xA3, 0x89, 0x6E, 0x81, 0xA4, 0x00, 0x9C, 0x15, 
-    0xA3, 0x8D, 0x89, 0x8B, 0x98, 0x03, 0xA4, 0x07, 0xA5, 0x88, 0x8D, 0x94, 
-    0xA6, 0x68, 0xA7, 0x3E, 0x04, 0xA8, 0x8D, 0x89, 0xA9, 0xAA, 0x12, 0x8F, 
-    0x99, 0xA3, 0x94, 0x88, 0x88, 0x89, 0x8B, 0x9A, 0xAB, 0x15, 0x98, 0x0F, 
-    0x9F, 0x8D, 0x8D, 0x8D, 0x97, 0x96, 0x66, 0x04, 0x9F, 0x8D, 0x94, 0x88, 
-    0x97, 0x48, 0x8F, 0x99, 0x6C, 0xAC, 0x00, 0x9F, 0x9A, 0xAD, 0xAE, 0xAF, 
-    0x00, 0x00, 0x00, 0x9F, 0x94, 0x88, 0x94, 0x88, 0x6E, 0xB0, 0x00, 0x9F, 
-    0x89, 0x6E, 0x81, 0x8B, 0x00, 0x3E, 0xB1, 0x6E, 0xAC, 0x81, 0x6E, 0x88, 
-    0x00, 0x00, 0x6C, 0x00, 0x00, 0x6C, 0x00, 0x6C, 0x3E, 0xB2, 0x3D, 0x9C, 
-    0xA6, 0xB3, 0xB4, 0x9F, 0x03, 0x03, 0x03, 0xA4, 0xA9, 0xB5, 0xB6, 0x8B, 
-    0x15, 0x15, 0x15, 0x98, 0xB7, 0x9B, 0xB8, 0x94, 0xAF, 0xAF, 0xAF, 0xAF, 
-    0xB9, 0x81, 0x8B, 0x9E, 0x8D, 0x8D, 0x94, 0x88, 0x89, 0x6E, 0xAC, 0xB0, 
-    0x94, 0x88, 0x89, 0x6E, 0x88, 0x00, 0x00, 0xBA, 0x89, 0x6E, 0xAC, 0x81, 
-    0x6E, 0x00, 0x00, 0x6C, 0xAC, 0x00, 0x00, 0x6C, 0x00, 0x00, 0x00, 0x00, 
-    0x7D, 0xBB, 0x15, 0x93, 0xBC, 0xBD, 0xBE, 0xBF, 0x97, 0xA3, 0x15, 0xAB, 
-    0xC0, 0xC0, 0x97, 0x9C, 0xBE, 0x97, 0x15, 0x15, 0xC1, 0x04, 0x15, 0x9C, 
-    0x97, 0x15, 0xC1, 0x04, 0xC2, 0xC3, 0xC1, 0x73, 0x15, 0xC1, 0x73, 0xC4, 
-    0xC5, 0xC6, 0x00, 0x00, 0x93, 0xC7, 0xC4, 0x73, 0xC4, 0x73, 0xA4, 0x00, 
-    0x97, 0xA3, 0x9C, 0x00, 0x00, 0x00, 0x06, 0x96, 0xAB, 0x97, 0x06, 0xC8, 
-    0xC9, 0x9C, 0x15, 0xCA, 0x04, 0x15, 0xAB, 0xC1, 0xCB, 0x06, 0xCC, 0xCD, 
-    0x00, 0xCE, 0x15, 0x7D, 0xBB, 0xC1, 0x86, 0xC0, 0x00, 0x97, 0x15, 0x97, 
-    0xA3, 0x06, 0x9C, 0xC1, 0x9C, 0xC1, 0x04, 0xCF, 0xB1, 0x15, 0x15, 0x9C, 
-    0xC1, 0x00, 0x00, 0x06, 0xC4, 0x04, 0x15, 0x06, 0x00, 0x00, 0x9C, 0x15, 
-    0x9C, 0x00, 0x15, 0x15, 0xA4, 0x00, 0x00, 0x15, 0x06, 0x9C, 0xC1, 0xB0, 
-    0xD0, 0xA4, 0x00, 0x15, 0xCA, 0xCB, 0xD1, 0x9F, 0x15, 0xC1, 0x00, 0xC5, 
-    0xC6, 0x04, 0x15, 0xD2, 0xCE, 0x06, 0xA4, 0x00, 0x73, 0xC4, 0x00, 0x73, 
-    0x97, 0x15, 0x9C, 0x00, 0xC4, 0x00, 0x00, 0x00, 0xC1, 0x04, 0x06, 0x9C, 
-    0x06, 0xA4, 0x00, 0xA4, 0x06, 0xC4, 0x04, 0xCA, 0xCB, 0x06, 0x9C, 0x06, 
-    0x8E, 0xD3, 0x00, 0xD4, 0xD5, 0x15, 0x15, 0x15, 0x8D, 0xCD, 0xD6, 0x15, 
-    0xC1, 0x04, 0x15, 0x15, 0x8D, 0xD7, 0x80, 0x8E, 0xC7, 0x9C, 0x15, 0x15, 
-    0xD8, 0x00, 0x00, 0x00, 0xD4, 0xD5, 0x97, 0x8D, 0x96, 0x96, 0x96, 0x9C, 
-    0x15, 0xCA, 0xD9, 0xD7, 0x00, 0x00, 0x15, 0x15, 0x15, 0xD4, 0xD2, 0x9F, 
-    0x00, 0xC4, 0x04, 0xC1, 0x8F, 0x00, 0xDA, 0x00, 0x9C, 0x06, 0x9C, 0x06, 
-    0xA4, 0x00, 0xCD, 0x94, 0x15, 0x15, 0xCA, 0xCB, 0x9C, 0x00, 0xDB, 0x8D, 
-    0xC1, 0x04, 0x7D, 0xDC, 0xBC, 0xBD, 0xA3, 0xD7, 0x06, 0xCC, 0xA3, 0x8D, 
-    0x8D, 0x8D, 0xD7, 0x00, 0xDD, 0xDE, 0x04, 0x00, 0x04, 0xDF, 0xE0, 0xE1, 
-    0xA4, 0xDE, 0x73, 0xE2, 0x9C, 0x15, 0xE3, 0xE4, 0x73, 0x00, 0x00, 0x73, 
-    0x9C, 0x15, 0x15, 0xE5, 0x00, 0x00, 0x81, 0xE6, 0xE2, 0x9C, 0x15, 0x15, 
-    0xE2, 0xE2, 0xE7, 0xE8, 0xE2, 0x9C, 0xA4, 0x9C, 0xBA, 0xA4, 0xE2, 0xE2, 
-    0xE2, 0x9C, 0xC4, 0xE2, 0xE9, 0xE2, 0x9C, 0x15, 0xC4, 0x9C, 0xA4, 0xE2, 
-    0xE8, 0xE2, 0x9C, 0x15, 0xA4, 0xE2, 0x00, 0xA4, 0xA4, 0x15, 0xC4, 0x00, 
-    0x78, 0xE8, 0xE2, 0xC3, 0xEA, 0xE0, 0xE0, 0xEB, 0xE2, 0xE2, 0xE2, 0xEC, 
-    0xED, 0xEE, 0xEF, 0xDC, 0x97, 0xC4, 0x00, 0x73, 0xC4, 0x9C, 0xC4, 0xDF, 
-    0x97, 0xE3, 0xEB, 0x00, 0x15, 0x15, 0xA4, 0x9C, 0x15, 0xE3, 0xF0, 0xE7, 
-    0x9C, 0xA4, 0xE2, 0x9C, 0x15, 0x15, 0xDE, 0xE9, 0xE2, 0x00, 0xA4, 0x15, 
-    0x15, 0xA4, 0xE2, 0x9C, 0xC4, 0xE2, 0xE2, 0x9C, 0xA4, 0xE2, 0x9C, 0xA4, 
-    0xF1, 0xE2, 0x9C, 0x15, 0xC4, 0xE2, 0x00, 0xF2, 0xF3, 0xE2, 0x9C, 0x15, 
-    0x15, 0x15, 0xDE, 0x09, 0xBA, 0xC4, 0x9C, 0x15, 0x15, 0x15, 0xC4, 0x00, 
-    0xE9, 0x97, 0x15, 0x15, 0x15, 0xA4, 0xE2, 0xE2, 0xE7, 0xE8, 0xDF, 0x97, 
-    0x15, 0xC4, 0xE7, 0xDC, 0x00, 0x00, 0x78, 0xBA, 0x15, 0x15, 0xE3, 0xE0, 
-    0x04, 0x00, 0x00, 0xE9, 0xF0, 0x9C, 0xA4, 0x9C, 0xA4, 0xDE, 0x04, 0xE7, 
-    0xE8, 0xDF, 0xF4, 0xBA, 0xD5, 0xA4, 0x00, 0xA4, 0xC4, 0x9C, 0x15, 0xC4, 
-    0xDD, 0xC4, 0x00, 0xA4, 0x15, 0x15, 0xA4, 0x9C, 0x73, 0xE2, 0xE2, 0x9C, 
-    0x15, 0x15, 0xDE, 0xA4, 0xE2, 0xE2, 0x9C, 0xA4, 0xEC, 0xD5, 0xC4, 0xDF, 
-    0x97, 0x15, 0x15, 0xC4, 0xEC, 0xF5, 0xDF, 0xA3, 0xF6, 0xD5, 0x15, 0x15, 
-    0xA4, 0xE2, 0xDF, 0xEF, 0xE5, 0xD5, 0xA4, 0x9C, 0xC4, 0xE2, 0xE2, 0xE2, 
-    0x15, 0xE3, 0xF4, 0xBA, 0xE3, 0xE1, 0x00, 0xA4, 
-};
-
-const unsigned short Merged_palette [] = {
-    0x7c1f, 0x0000, 0x1ce7, 0x2108, 0x294a, 0x0012, 0x7bde, 0x77bd, 0x739c, 
-    0x0009, 0x319f, 0x1ce8, 0x4631, 0x0c6c, 0x319e, 0x0421, 0x0002, 0x4211, 
-    0x0001, 0x0400, 0x54e0, 0x7fff, 0x7d40, 0x001f, 0x50c0, 0x081c, 0x2929, 
-    0x5672, 0x041d, 0x2462, 0x6d21, 0x6d23, 0x0015, 0x0813, 0x2872, 0x001c, 
-    0x6d22, 0x2862, 0x1980, 0x0935, 0x12f1, 0x2664, 0x2620, 0x0db1, 0x1da9, 
-    0x1ec9, 0x033f, 0x1acd, 0x009f, 0x11ad, 0x2665, 0x1a0d, 0x1211, 0x1960, 
-    0x000b, 0x1111, 0x001e, 0x7520, 0x001d, 0x6107, 0x001a, 0x0004, 0x4a52, 
-    0x4a59, 0x000c, 0x1859, 0x48c0, 0x0420, 0x7fe0, 0x7bc0, 0x6f60, 0x77a0, 
-    0x14a5, 0x0633, 0x056c, 0x0010, 0x4231, 0x00f0, 0x039e, 0x0422, 0x00f3, 
-    0x2d7e, 0x003f, 0x00ae, 0x039f, 0x07bf, 0x09ae, 0x025f, 0x439f, 0x739f, 
-    0x0021, 0x0011, 0x023e, 0x042d, 0x0611, 0x057d, 0x00fc, 0x004b, 0x43be, 
-    0x02d8, 0x5efd, 0x0017, 0x5ef7, 0x02d7, 0x5ef8, 0x037d, 0x5f39, 0x5ef9, 
-    0x4a46, 0x2d76, 0x5286, 0x0014, 0x4e66, 0x7395, 0x5293, 0x2529, 0x2956, 
-    0x000a, 0x7389, 0x042b, 0x2523, 0x2945, 0x4a47, 0x2537, 0x4e73, 0x7bdc, 
-    0x294b, 0x56a8, 0x2944, 0x2943, 0x4a53, 0x738f, 0x4a4f, 0x2524, 0x2949, 
-    0x1081, 0x77a9, 0x3183, 0x2102, 0x6b48, 0x18c2, 0x7fea, 0x7fee, 0x18c6, 
-    0x3188, 0x6b4e, 0x7fef, 0x7ffc, 0x6307, 0x6315, 0x6318, 0x7ffb, 0x318c, 
-    0x6b5a, 0x7ff6, 0x6317, 0x6739, 0x3189, 0x14a1, 0x6728, 0x3184, 0x7ff2, 
-    0x7feb, 0x7fed, 0x5294, 0x630b, 0x631f, 0x1084, 0x6b49, 0x295d, 0x042c, 
-    0x7ffe, 0x5ee7, 0x3186, 0x6b55, 0x7ff9, 0x2947, 0x2946, 0x1097, 0x77b2, 
-    0x14a2, 0x6b5f, 0x3187, 0x6b56, 0x77ac, 0x630a, 0x6735, 0x6731, 0x7bcd, 
-    0x6729, 0x7ff0, 0x6f77, 0x7ffa, 0x6f7b, 0x673e, 0x14b9, 0x56b5, 0x252a, 
-    0x56bb, 0x7bd0, 0x5298, 0x1098, 0x6f7f, 0x295f, 0x6736, 0x7bc9, 0x7ff1, 
-    0x6f7a, 0x253e, 0x7bdb, 0x673b, 0x672c, 0x7bdf, 0x673f, 0x672b, 0x6f68, 
-    0x0426, 0x295b, 0x6f6c, 0x7ff7, 0x672e, 0x5299, 0x2d6b, 0x6732, 0x7ff4, 
-    0x2d67, 0x3def, 0x7ff8, 0x2d71, 0x56bf, 0x3dec, 0x3de8, 0x3deb, 0x528d, 
-    0x5292, 0x56b1, 0x3df9, 0x3dee, 0x672f, 0x528a, 0x5291, 0x252f, 0x2534, 
-    0x3df1, 0x56aa, 0x3df4, 0x529b, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 
-    0x0000, 0x0000, 0x0000, 0x0000
-};
-
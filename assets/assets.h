@@ -0,0 +1,61 @@
+/* assets.h
+ * generated by assetconv from assets.txt */
+
+/* how tile data is stored, the BIOS header types, and _bytes is the
+ * unpacked size */
+#define ASSET_RAW 0x00
+#define ASSET_LZ77 0x10
+#define ASSET_RL 0x30
+
+/* Sprites */
+#define Sprites_8bpp_tiles 58
+enum SpritesTiles {
+    TILE_PLAYER = 0, /* 16x16 */
+    TILE_BOSS = 8, /* 16x16 */
+    TILE_ENEMY1 = 16, /* 16x16 */
+    TILE_ENEMY2 = 24, /* 16x16 */
+    TILE_EXPLOSION1 = 32, /* 16x16 */
+    TILE_EXPLOSION2 = 40, /* 16x16 */
+    TILE_PEX1 = 48, /* 16x16 */
+    TILE_ENEMYBULLET = 56, /* 8x8 */
+    TILE_PLAYERBULLET = 58, /* 8x8 */
+};
+enum SpritesPalettes {
+    PAL_PLAYER = 0, /* 8bpp */
+    PAL_BOSS = 0, /* 8bpp */
+    PAL_ENEMY1 = 0, /* 8bpp */
+    PAL_ENEMY2 = 0, /* 8bpp */
+    PAL_EXPLOSION1 = 0, /* 8bpp */
+    PAL_EXPLOSION2 = 0, /* 8bpp */
+    PAL_PEX1 = 0, /* 8bpp */
+    PAL_ENEMYBULLET = 0, /* 8bpp */
+    PAL_PLAYERBULLET = 0,
+};
+extern const unsigned char Sprites_data[];
+#define Sprites_data_bytes 1888
+#define Sprites_data_format ASSET_RAW
+extern const unsigned short Sprites_palette[];
+#define Sprites_palette_bytes 500
+
+/* Font */
+#define Font_first 32
+#define Font_glyphs 96
+extern const unsigned char Font_data[];
+#define Font_data_bytes 3072
+#define Font_data_format ASSET_LZ77
+extern const unsigned short Font_palette[];
+#define Font_palette_bytes 32
+
+/* SpaceStage, a map of SpaceBackground */
+#define SpaceStage_rows 32
+extern const unsigned short SpaceStage_data[];
+#define SpaceStage_data_bytes 588
+
+/* SpaceBackground */
+#define SpaceBackground_width 144
+#define SpaceBackground_height 72
+extern const unsigned char SpaceBackground_data[];
+#define SpaceBackground_data_bytes 1856
+#define SpaceBackground_data_format ASSET_RL
+extern const unsigned short SpaceBackground_palette[];
+#define SpaceBackground_palette_bytes 512
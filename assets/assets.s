@@ -0,0 +1,39 @@
+@ assets.s
+@ generated by assetconv from assets.txt
+
+.section .rodata
+
+.global Sprites_data
+.align 2
+Sprites_data:
+    .incbin "assets/Sprites.img.bin"
+
+.global Sprites_palette
+.align 2
+Sprites_palette:
+    .incbin "assets/Sprites.pal.bin"
+
+.global Font_data
+.align 2
+Font_data:
+    .incbin "assets/Font.img.bin"
+
+.global Font_palette
+.align 2
+Font_palette:
+    .incbin "assets/Font.pal.bin"
+
+.global SpaceStage_data
+.align 2
+SpaceStage_data:
+    .incbin "assets/SpaceStage.map.bin"
+
+.global SpaceBackground_data
+.align 2
+SpaceBackground_data:
+    .incbin "assets/SpaceBackground.img.bin"
+
+.global SpaceBackground_palette
+.align 2
+SpaceBackground_palette:
+    .incbin "assets/SpaceBackground.pal.bin"
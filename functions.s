@@ -1,37 +1,92 @@
 @functions.s
 
+@ add the points for killing an enemy to the score
+@ r0 = score, r1 = pointer to the enemy's archetype, its first word is the score
 .global increaseScore
 increaseScore:
-    cmp r1, #8
-    beq .boss
-    cmp r1, #16
-    beq .enemy1
-    @enemy2
-    add r0, r0, #20
-    b .end
-.boss:
-    add r0, r0, #150
-    add r0, r0, #100
-    add r0, r0, #100
-    b .end
-.enemy1:
-    add r0, r0, #15
-.end:
+    ldr r1, [r1]
+    add r0, r0, r1
     mov pc, lr
 
 
-.global getOffsetForNum
-getOffsetForNum:
-    mov r1, #0
-    mov r2, #44
-.top:
-    cmp r1, r0
-    beq .endOff
-    add r2, r2, #2
-    add r1, r1, #1
-    b .top
-.endOff:
-    mov r0, r2
+@ BIOS VBlankIntrWait, halts until the next vblank interrupt
+.global vblankIntrWait
+vblankIntrWait:
+    swi #0x50000
     mov pc, lr
 
 
+@ BIOS CpuFastSet, r0 = source, r1 = dest, r2 = word count and mode
+.global cpuFastSet
+cpuFastSet:
+    swi #0xC0000
+    mov pc, lr
+
+
+@ BIOS CpuSet, r0 = source, r1 = dest, r2 = count and mode
+.global cpuSet
+cpuSet:
+    swi #0xB0000
+    mov pc, lr
+
+
+@ the bulk copy and fill run from IWRAM, which has no wait states - the
+@ linker script has to place .iwram there and copy it over at boot, as
+@ devkitARM's gba_cart.ld does, and C calls them with long_call
+.section .iwram, "ax", %progbits
+.align 2
+.arm
+
+@ copy words 32 bytes at a time
+@ r0 = dest, r1 = source, r2 = bytes (a multiple of 4)
+.global memcpy32
+memcpy32:
+    stmfd sp!, {r4-r10}
+    subs r2, r2, #32
+    blt .copyTail
+.copyBlock:
+    ldmia r1!, {r3-r10}
+    stmia r0!, {r3-r10}
+    subs r2, r2, #32
+    bge .copyBlock
+.copyTail:
+    adds r2, r2, #32
+    beq .copyEnd
+.copyWord:
+    ldr r3, [r1], #4
+    str r3, [r0], #4
+    subs r2, r2, #4
+    bgt .copyWord
+.copyEnd:
+    ldmfd sp!, {r4-r10}
+    mov pc, lr
+
+
+@ fill words 32 bytes at a time
+@ r0 = dest, r1 = value, r2 = bytes (a multiple of 4)
+.global memset32
+memset32:
+    stmfd sp!, {r4-r9}
+    mov r3, r1
+    mov r4, r1
+    mov r5, r1
+    mov r6, r1
+    mov r7, r1
+    mov r8, r1
+    mov r9, r1
+    subs r2, r2, #32
+    blt .fillTail
+.fillBlock:
+    stmia r0!, {r1, r3-r9}
+    subs r2, r2, #32
+    bge .fillBlock
+.fillTail:
+    adds r2, r2, #32
+    beq .fillEnd
+.fillWord:
+    str r1, [r0], #4
+    subs r2, r2, #4
+    bgt .fillWord
+.fillEnd:
+    ldmfd sp!, {r4-r9}
+    mov pc, lr
@@ -0,0 +1,337 @@
+/*
+ * save.h
+ * the layout of the saved high score table, shared by the game and the
+ * host tool tools/savetool.c which reads and writes save files
+ *
+ * the table is a header then the entries, best first, kept as an image in
+ * RAM and copied to the save memory a byte at a time - the header holds a
+ * magic, the version of the layout and a CRC of everything after it, so a
+ * blank, old or half written save is thrown away for the default table
+ *
+ * SRAM is written over in place, so it holds two copies of the table and
+ * a save goes over the older one, leaving the newer alone until the new
+ * one is down - but flash can only clear bits and has to be erased a 4K
+ * sector at a time, which takes milliseconds - so on flash each save is a
+ * new record in a journal over two sectors, and once one fills the other
+ * is erased and filled in turn, spreading the wear the same way
+ */
+
+#ifndef SAVE_H
+#define SAVE_H
+
+/* the number of scores kept */
+#define SCORE_ENTRIES 10
+
+/* the letters of a name */
+#define SCORE_NAME 3
+
+/* bump this when the layout changes */
+#define SAVE_VERSION 1
+
+/* the start of every save */
+#define SAVE_MAGIC "GLXS"
+
+struct SaveHeader {
+    char magic[4];
+    unsigned char version;
+    unsigned char entries;
+
+    /* the CRC of the entries, low byte first */
+    unsigned char crc[2];
+};
+
+/* one score, 8 bytes */
+struct ScoreEntry {
+    /* low byte first, the same on the GBA and a PC */
+    unsigned int score;
+    char name[SCORE_NAME];
+    unsigned char stage;
+};
+
+struct ScoreTable {
+    struct SaveHeader header;
+    struct ScoreEntry entries[SCORE_ENTRIES];
+};
+
+/* the CRC-16-CCITT of some bytes */
+static unsigned short save_crc(const unsigned char* data, int bytes) {
+    unsigned short crc = 0xffff;
+    for (int i = 0; i < bytes; i++) {
+        crc ^= data[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+/* fill in the header for the entries as they are now */
+static void save_seal(struct ScoreTable* table) {
+    unsigned short crc = save_crc((const unsigned char*) table->entries,
+            sizeof(table->entries));
+    for (int i = 0; i < 4; i++) {
+        table->header.magic[i] = SAVE_MAGIC[i];
+    }
+    table->header.version = SAVE_VERSION;
+    table->header.entries = SCORE_ENTRIES;
+    table->header.crc[0] = crc & 0xff;
+    table->header.crc[1] = crc >> 8;
+}
+
+/* check a table read back from a save, returns 0 if it can't be used */
+static int save_valid(const struct ScoreTable* table) {
+    for (int i = 0; i < 4; i++) {
+        if (table->header.magic[i] != SAVE_MAGIC[i]) {
+            return 0;
+        }
+    }
+    if (table->header.version != SAVE_VERSION ||
+            table->header.entries != SCORE_ENTRIES) {
+        return 0;
+    }
+    unsigned short crc = save_crc((const unsigned char*) table->entries,
+            sizeof(table->entries));
+    return table->header.crc[0] == (crc & 0xff) && table->header.crc[1] == (crc >> 8);
+}
+
+/* the table before anyone has played, descending scores */
+static void save_defaults(struct ScoreTable* table) {
+    for (int i = 0; i < SCORE_ENTRIES; i++) {
+        table->entries[i].score = (SCORE_ENTRIES - i) * 10;
+        for (int j = 0; j < SCORE_NAME; j++) {
+            table->entries[i].name[j] = 'A';
+        }
+        table->entries[i].stage = 1;
+    }
+    save_seal(table);
+}
+
+/* put a score in its place in the table, returns its rank or -1 if it
+ * isn't good enough - a tie goes below the older score */
+static int save_insert(struct ScoreTable* table, unsigned int score,
+        const char* name, int stage) {
+    int rank = 0;
+    while (rank < SCORE_ENTRIES && table->entries[rank].score >= score) {
+        rank++;
+    }
+    if (rank == SCORE_ENTRIES) {
+        return -1;
+    }
+    for (int i = SCORE_ENTRIES - 1; i > rank; i--) {
+        table->entries[i] = table->entries[i - 1];
+    }
+    struct ScoreEntry* e = &table->entries[rank];
+    e->score = score;
+    for (int j = 0; j < SCORE_NAME; j++) {
+        e->name[j] = name[j];
+    }
+    e->stage = stage;
+    save_seal(table);
+    return rank;
+}
+
+/* the SRAM copies, each followed by a generation byte which counts up
+ * with every save and is written after the table, so a copy only takes
+ * over from the other once the whole of it is down */
+#define SRAM_COPY_BYTES 0x80
+#define SRAM_COPIES 2
+
+_Static_assert(sizeof(struct ScoreTable) + 1 <= SRAM_COPY_BYTES,
+        "a table doesn't fit its SRAM copy");
+
+/* the SRAM, supplied by the game or the host tool like the flash below */
+unsigned char sram_read(int address);
+
+/* the address of a copy's generation byte */
+static inline int sram_generation(int copy) {
+    return copy * SRAM_COPY_BYTES + sizeof(struct ScoreTable);
+}
+
+/* copy out the newer good table and its generation, returns which copy
+ * it is or -1 if neither is good */
+static inline int sram_recover(struct ScoreTable* table, unsigned char* generation) {
+    struct ScoreTable copy_table;
+    unsigned char* bytes = (unsigned char*) &copy_table;
+    int newest = -1;
+    for (int copy = 0; copy < SRAM_COPIES; copy++) {
+        for (int i = 0; i < (int) sizeof(copy_table); i++) {
+            bytes[i] = sram_read(copy * SRAM_COPY_BYTES + i);
+        }
+        unsigned char g = sram_read(sram_generation(copy));
+        if (save_valid(&copy_table) &&
+                (newest < 0 || (signed char) (g - *generation) > 0)) {
+            newest = copy;
+            *generation = g;
+            *table = copy_table;
+        }
+    }
+    return newest;
+}
+
+/* the flash journal, two sectors of records */
+#define FLASH_SECTOR 0x1000
+#define JOURNAL_SECTORS 2
+#define RECORD_SIZE 96
+#define RECORD_SLOTS (FLASH_SECTOR / RECORD_SIZE)
+
+/* a save in the journal - the sequence counts up with every save, and
+ * its complement is last so it is the last thing programmed - a record is
+ * only good once the two agree, so one cut off part way, even inside the
+ * sequence whose unwritten bytes read as 0xff, is never the newest */
+struct SaveRecord {
+    struct ScoreTable table;
+    unsigned int sequence;
+    unsigned int check;
+};
+_Static_assert(sizeof(struct SaveRecord) <= RECORD_SIZE, "a record doesn't fit its slot");
+
+/* the journal's writing job, done a step at a time */
+#define JOURNAL_IDLE 0
+#define JOURNAL_PROGRAM 1
+
+struct Journal {
+    /* the slot of the newest good record (-1 if none) and its sequence */
+    int newest;
+    unsigned int sequence;
+
+    /* the slot the next record goes in */
+    int next;
+
+    /* set when the table should be saved, several saves before the job
+     * starts are only written once */
+    int pending;
+
+    int state;
+
+    /* the record being written and the next byte of it */
+    struct SaveRecord record;
+    int offset;
+
+    /* the byte an erase or program is waiting to read back, or -1 */
+    int wait_address;
+    unsigned char wait_value;
+};
+
+/* the flash, supplied by the game (the real chip) or the host tool (a
+ * file) - erase and program only start the operation, and reads return
+ * the chip's status rather than the data until it is done */
+unsigned char flash_read(int address);
+void flash_erase(int sector);
+void flash_program(int address, unsigned char value);
+
+/* the flash address of a slot */
+static inline int journal_address(int slot) {
+    return (slot / RECORD_SLOTS) * FLASH_SECTOR + (slot % RECORD_SLOTS) * RECORD_SIZE;
+}
+
+/* whether a slot has never been written */
+static inline int journal_blank(int slot) {
+    int address = journal_address(slot);
+    for (int i = 0; i < RECORD_SIZE; i++) {
+        if (flash_read(address + i) != 0xff) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* the first slot of the sector after the one a slot is in */
+static inline int journal_other_sector(int slot) {
+    return (slot / RECORD_SLOTS + 1) % JOURNAL_SECTORS * RECORD_SLOTS;
+}
+
+/* find the newest good record, copying its table out, and where the next
+ * one goes - returns 0 if there is none */
+static inline int journal_recover(struct Journal* j, struct ScoreTable* table) {
+    struct SaveRecord record;
+    unsigned char* bytes = (unsigned char*) &record;
+    j->newest = -1;
+    j->sequence = 0;
+    for (int slot = 0; slot < RECORD_SLOTS * JOURNAL_SECTORS; slot++) {
+        int address = journal_address(slot);
+        for (int i = 0; i < (int) sizeof(record); i++) {
+            bytes[i] = flash_read(address + i);
+        }
+        if (record.check == ~record.sequence && save_valid(&record.table) &&
+                (j->newest < 0 || record.sequence > j->sequence)) {
+            j->newest = slot;
+            j->sequence = record.sequence;
+            *table = record.table;
+        }
+    }
+
+    /* after the newest, skipping any cut off records, or the start of the
+     * other sector once this one is used up */
+    if (j->newest < 0) {
+        j->next = 0;
+    } else {
+        j->next = j->newest + 1;
+        while (j->next % RECORD_SLOTS && !journal_blank(j->next)) {
+            j->next++;
+        }
+        if (j->next % RECORD_SLOTS == 0) {
+            j->next = journal_other_sector(j->newest);
+        }
+    }
+    j->pending = 0;
+    j->state = JOURNAL_IDLE;
+    j->wait_address = -1;
+    return j->newest >= 0;
+}
+
+/* do the next bit of the job without waiting on the flash, returns 0 when
+ * there is nothing left to do */
+static inline int journal_step(struct Journal* j, const struct ScoreTable* table) {
+    if (j->wait_address >= 0) {
+        if (flash_read(j->wait_address) != j->wait_value) {
+            return 1;
+        }
+        j->wait_address = -1;
+    }
+
+    if (j->state == JOURNAL_IDLE) {
+        if (!j->pending) {
+            return 0;
+        }
+        j->pending = 0;
+        j->record.table = *table;
+        j->record.sequence = j->sequence + 1;
+        j->record.check = ~j->record.sequence;
+        j->offset = 0;
+        j->state = JOURNAL_PROGRAM;
+
+        /* a record at the start of a sector erases it, which only loses
+         * records older than the ones in the other sector */
+        if (j->next % RECORD_SLOTS == 0) {
+            flash_erase(j->next / RECORD_SLOTS);
+            j->wait_address = journal_address(j->next);
+            j->wait_value = 0xff;
+        }
+        return 1;
+    }
+
+    /* program the next byte, the erased ones are already there */
+    const unsigned char* bytes = (const unsigned char*) &j->record;
+    while (j->offset < (int) sizeof(j->record)) {
+        unsigned char value = bytes[j->offset];
+        int address = journal_address(j->next) + j->offset++;
+        if (value != 0xff) {
+            flash_program(address, value);
+            j->wait_address = address;
+            j->wait_value = value;
+            return 1;
+        }
+    }
+
+    /* the record is down */
+    j->newest = j->next;
+    j->sequence = j->record.sequence;
+    j->next++;
+    if (j->next % RECORD_SLOTS == 0) {
+        j->next = journal_other_sector(j->newest);
+    }
+    j->state = JOURNAL_IDLE;
+    return 1;
+}
+
+#endif
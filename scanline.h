@@ -0,0 +1,69 @@
+/*
+ * scanline.h
+ * the generators of the per scanline scroll tables for the space
+ * background, shared by the game and the host tool tools/scanbench.c
+ * which times them
+ *
+ * a table has an entry for every line plus one, each a word with the x
+ * scroll in the low half and the y scroll in the high half, so one 32 bit
+ * HBlank DMA sets both registers
+ */
+
+#ifndef SCANLINE_H
+#define SCANLINE_H
+
+/* the number of visible scanlines */
+#define SCANLINES 160
+
+/* the scanline effects on the space background */
+#define SCANLINE_NONE 0
+#define SCANLINE_WARP 1
+#define SCANLINE_STRETCH 2
+
+/* one sine cycle in 64 steps, scaled to +-127 */
+static const signed char sine_table[64] = {
+    0, 12, 25, 37, 49, 60, 71, 81, 90, 98, 106, 112, 117, 122, 125, 126,
+    127, 126, 125, 122, 117, 112, 106, 98, 90, 81, 71, 60, 49, 37, 25, 12,
+    0, -12, -25, -37, -49, -60, -71, -81, -90, -98, -106, -112, -117, -122, -125, -126,
+    -127, -126, -125, -122, -117, -112, -106, -98, -90, -81, -71, -60, -49, -37, -25, -12,
+};
+
+/* fill a table with a horizontal sine wave of some amplitude in pixels */
+static void scanline_wave(unsigned int* table, int x, int y, int amplitude, int phase) {
+    for (int line = 0; line <= SCANLINES; line++) {
+        int dx = (sine_table[(line * 2 + phase) & 63] * amplitude) >> 7;
+        table[line] = ((x + dx) & 0xffff) | ((y & 0xffff) << 16);
+    }
+}
+
+/* fill a table which squashes the background vertically, scale is the
+ * number of background lines per screen line in 8.8 fixed point - bottom
+ * is the first line past the map rows streamed in, and lines from there
+ * down repeat the one above it rather than show rows not streamed yet */
+static void scanline_stretch(unsigned int* table, int x, int y, int bottom, int scale) {
+    int row = 0;
+    for (int line = 0; line <= SCANLINES; line++) {
+        int source = y + (row >> 8);
+        if (source >= bottom) {
+            source = bottom - 1;
+        }
+        table[line] = (x & 0xffff) | (((source - line) & 0xffff) << 16);
+        row += scale;
+    }
+}
+
+
+/* fill a table for a frame of an effect, with some frames left of its
+ * length, and bottom the end of the map streamed in */
+static void scanline_build(unsigned int* table, int effect, int x, int y, int bottom,
+        int left, int length) {
+    if (effect == SCANLINE_WARP) {
+        /* the wave dies down from 32 pixels as the effect runs out */
+        scanline_wave(table, x, y, (left * 32) / length, left * 2);
+    } else {
+        /* start squashed to three lines per line and relax to normal */
+        scanline_stretch(table, x, y, bottom, 0x100 + (left * 0x200) / length);
+    }
+}
+
+#endif
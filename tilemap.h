@@ -0,0 +1,142 @@
+/*
+ * tilemap.h
+ * finding the entry of a tile map a screen coordinate lands on, shared by
+ * the game and the host tool tools/tilebench.c which times them
+ *
+ * a map bigger than 32x32 is made of 32x32 screen blocks of 0x400
+ * entries, left to right then top to bottom, and wraps around at its
+ * edges like the hardware does
+ */
+
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+/* finds which tile a screen coordinate maps to,
+ * taking scroll into account */
+static inline unsigned short tile_lookup(int x, int y, int xscroll, int yscroll,
+        const unsigned short* tilemap, int tilemap_w, int tilemap_h) {
+
+    /* adjust for the scroll */
+    x += xscroll;
+    y += yscroll;
+
+    /* convert from screen coordinates to tile coordinates */
+    x >>= 3;
+    y >>= 3;
+
+    /* account for wraparound */
+    while (x >= tilemap_w) {
+        x -= tilemap_w;
+    }
+    while (y >= tilemap_h) {
+        y -= tilemap_h;
+    }
+    while (x < 0) {
+        x += tilemap_w;
+    }
+    while (y < 0) {
+        y += tilemap_h;
+    }
+
+    /* the larger screen maps (bigger than 32x32) are made of multiple
+     * stitched
+       together - the offset is used for finding which screen block we
+       are in
+       for these cases */
+    int offset = 0;
+
+    /* if the width is 64, add 0x400 offset to get to tile maps on right  */
+    if (tilemap_w == 64 && x >= 32) {
+        x -= 32;
+        offset += 0x400;
+    }
+
+    /* if height is 64 and were down there */
+    if (tilemap_h == 64 && y >= 32) {
+        y -= 32;
+
+        /* if width is also 64 add 0x800, else just 0x400 */
+        if (tilemap_w == 64) {
+            offset += 0x800;
+        } else {
+            offset += 0x400;
+        }
+    }
+
+    /* find the index in this tile map */
+    int index = y * 32 + x;
+
+    /* return the tile */
+    return tilemap[index + offset];
+}
+
+/* the index of tile x, y in a map made of 32x32 screen blocks, for map
+ * sizes that are powers of two - the sizes are constants at every call so
+ * the wrap is a mask and the screen block offset folds to shifts */
+static inline int tile_index_pow2(int x, int y, const int w, const int h) {
+    /* account for wraparound */
+    x &= w - 1;
+    y &= h - 1;
+
+    /* blocks go left to right then top to bottom, 0x400 entries each */
+    int offset = ((x >> 5) + (y >> 5) * (w >> 5)) << 10;
+    return offset + (y & 31) * 32 + (x & 31);
+}
+
+/* tile_lookup for one map size, where both sizes are powers of two */
+static inline unsigned short tile_lookup_pow2(int x, int y, int xscroll, int yscroll,
+        const unsigned short* tilemap, const int w, const int h) {
+    return tilemap[tile_index_pow2((x + xscroll) >> 3, (y + yscroll) >> 3, w, h)];
+}
+
+/* resolve count tiles going right from a screen coordinate into dest */
+static inline void tile_row_pow2(int x, int y, int xscroll, int yscroll,
+        const unsigned short* tilemap, unsigned short* dest, int count,
+        const int w, const int h) {
+    int tx = (x + xscroll) >> 3;
+    int ty = (y + yscroll) >> 3;
+    for (int i = 0; i < count; i++) {
+        dest[i] = tilemap[tile_index_pow2(tx + i, ty, w, h)];
+    }
+}
+
+/* resolve count tiles going down from a screen coordinate into dest */
+static inline void tile_column_pow2(int x, int y, int xscroll, int yscroll,
+        const unsigned short* tilemap, unsigned short* dest, int count,
+        const int w, const int h) {
+    int tx = (x + xscroll) >> 3;
+    int ty = (y + yscroll) >> 3;
+    for (int i = 0; i < count; i++) {
+        dest[i] = tilemap[tile_index_pow2(tx, ty + i, w, h)];
+    }
+}
+
+/* the lookups for each of the regular background sizes */
+static inline unsigned short tile_lookup_32x32(int x, int y, int xscroll, int yscroll,
+        const unsigned short* tilemap) {
+    return tile_lookup_pow2(x, y, xscroll, yscroll, tilemap, 32, 32);
+}
+static inline unsigned short tile_lookup_64x32(int x, int y, int xscroll, int yscroll,
+        const unsigned short* tilemap) {
+    return tile_lookup_pow2(x, y, xscroll, yscroll, tilemap, 64, 32);
+}
+static inline unsigned short tile_lookup_32x64(int x, int y, int xscroll, int yscroll,
+        const unsigned short* tilemap) {
+    return tile_lookup_pow2(x, y, xscroll, yscroll, tilemap, 32, 64);
+}
+static inline unsigned short tile_lookup_64x64(int x, int y, int xscroll, int yscroll,
+        const unsigned short* tilemap) {
+    return tile_lookup_pow2(x, y, xscroll, yscroll, tilemap, 64, 64);
+}
+
+/* the row and column lookups for a 32x32 map */
+static inline void tile_row_32x32(int x, int y, int xscroll, int yscroll,
+        const unsigned short* tilemap, unsigned short* dest, int count) {
+    tile_row_pow2(x, y, xscroll, yscroll, tilemap, dest, count, 32, 32);
+}
+static inline void tile_column_32x32(int x, int y, int xscroll, int yscroll,
+        const unsigned short* tilemap, unsigned short* dest, int count) {
+    tile_column_pow2(x, y, xscroll, yscroll, tilemap, dest, count, 32, 32);
+}
+
+#endif
@@ -6,13 +6,22 @@
 /* palette is always 256 colors */
 #define PALETTE_SIZE 256
 
-/* include the image we are using */
-#include "SpaceBackgroundImage.h"
+/* include the images we are using, with the tile start of each sprite -
+ * generated from assets.txt by tools/assetconv, assets/assets.s links
+ * the data itself into the ROM */
+#include "assets/assets.h"
 
-#include "Sprites/Merged.h"
+/* the layout of the saved high scores */
+#include "save.h"
 
-/* include the tile map we are using */
-#include "SpaceBackgroundMap.h"
+/* the scanline scroll table generators */
+#include "scanline.h"
+
+/* the tile map lookups */
+#include "tilemap.h"
+
+/* offsetof, for checking layouts the assembly relies on */
+#include <stddef.h>
 /* the width and height of the screen */
 #define WIDTH 240
 #define HEIGHT 160
@@ -28,33 +37,13 @@
 #define BG2_ENABLE 0x400
 #define BG3_ENABLE 0x800
 
-/* define start of tile block for each sprite */
-#define Boss 8
-#define Enemy1 16
-#define Enemy2 24
-#define SCORE 32
-#define EnemyBullet 42
-#define PlayerBullet 40
-#define Zero 44
-#define One 46
-#define Two 48
-#define Three 50
-#define Four 52
-#define Five 54
-#define Six 56
-#define Seven 58
-#define Eight 60
-#define Nine 62
-#define Explosion1 64
-#define Explosion2 72
-#define PEx1 80
-#define PEx2 88
-#define PEx3 96
-#define PEx4 104
-
 /* Global Score*/
 int SSCORE =0;
 
+/* the best score so far, and the lives the player has left */
+int high_score = 0;
+int player_lives = 3;
+
 /* flags to set sprite handling in display control register */
 #define SPRITE_MAP_2D 0x0
 #define SPRITE_MAP_1D 0x40
@@ -63,6 +52,10 @@ int SSCORE =0;
 /* there are 128 sprites on the GBA */
 #define NUM_SPRITES 128
 
+/* sprites past the hardware ones are objects, which the multiplexer shows
+ * in whatever hardware sprites are free each frame */
+#define NUM_OBJECTS 192
+
 /* the memory location which controls sprite attributes */
 volatile unsigned short* sprite_attribute_memory = 
     (volatile unsigned short*) 0x7000000;
@@ -81,6 +74,16 @@ volatile unsigned short* sprite_palette =
 #define DMA_16 0x00000000
 #define DMA_32 0x04000000
 
+/* flags for DMA destination control, repeating and start timing */
+#define DMA_DEST_RELOAD 0x00600000
+#define DMA_REPEAT 0x02000000
+#define DMA_AT_HBLANK 0x20000000
+
+/* pointers to the DMA channel 0 registers, used for scanline effects */
+volatile unsigned int* dma0_source = (volatile unsigned int*) 0x40000B0;
+volatile unsigned int* dma0_destination = (volatile unsigned int*) 0x40000B4;
+volatile unsigned int* dma0_count = (volatile unsigned int*) 0x40000B8;
+
 /* pointer to the DMA source location */
 volatile unsigned int* dma_source = (volatile unsigned int*) 0x40000D4;
 
@@ -97,8 +100,165 @@ void memcpy16_dma(unsigned short* dest, unsigned short* source ,int amount){
     *dma_count = amount | DMA_16 | DMA_ENABLE;
 }
 
-/*declaration of increaseScore*/
-int increaseScore(int score,int offset);
+/* copy data using 32 bit DMA, amount is in words - the DMA ignores the
+ * low bits of the addresses, so both must be word aligned */
+void memcpy32_dma(void* dest, const void* source, int amount){
+    *dma_source = (unsigned int) source;
+    *dma_destination = (unsigned int) dest;
+    *dma_count = amount | DMA_32 | DMA_ENABLE;
+}
+
+/* the memory functions in functions.s, memcpy32 and memset32 run from
+ * IWRAM and move 32 bytes per ldmia/stmia, the addresses must be word
+ * aligned and bytes a multiple of 4 - IWRAM is further from the ROM than a
+ * bl reaches, so they are called through a register (the attribute is
+ * ARM only, the host syntax check leaves it out) */
+#ifdef __arm__
+#define IWRAM_CALL __attribute__((long_call))
+#else
+#define IWRAM_CALL
+#endif
+void memcpy32(void* dest, const void* source, int bytes) IWRAM_CALL;
+void memset32(void* dest, unsigned int value, int bytes) IWRAM_CALL;
+
+/* the BIOS CpuFastSet and CpuSet calls, mode is the word count (a multiple
+ * of 8 for cpuFastSet) or'd with the flags below */
+void cpuFastSet(const void* source, void* dest, unsigned int mode);
+void cpuSet(const void* source, void* dest, unsigned int mode);
+
+/* fill dest with the first word of source instead of copying */
+#define CPUSET_FILL (1 << 24)
+
+/* copy words rather than halfwords, cpuSet only */
+#define CPUSET_32 (1 << 26)
+
+/* the interrupt registers */
+volatile unsigned short* interrupt_enable = (volatile unsigned short*) 0x4000208;
+volatile unsigned short* interrupt_selection = (volatile unsigned short*) 0x4000200;
+volatile unsigned short* interrupt_state = (volatile unsigned short*) 0x4000202;
+volatile unsigned int* interrupt_callback = (volatile unsigned int*) 0x3007FFC;
+
+/* the BIOS's copy of the interrupts which have happened, which
+ * VBlankIntrWait waits on */
+volatile unsigned short* bios_interrupt_flags = (volatile unsigned short*) 0x3007FF8;
+volatile unsigned short* display_interrupts = (volatile unsigned short*) 0x4000004;
+
+/* the bits for the vblank and vcount interrupts */
+#define INTERRUPT_VBLANK 0x1
+#define INTERRUPT_VCOUNT 0x4
+
+/* the priorities of queued transfers, lower ones go first */
+#define DMA_PRIORITY_OAM 0
+#define DMA_PRIORITY_PALETTE 1
+#define DMA_PRIORITY_MAP 2
+#define DMA_PRIORITY_TILES 3
+#define DMA_PRIORITIES 4
+
+/* the most transfers waiting at once */
+#define DMA_QUEUE_SIZE 32
+
+/* the most bytes moved in one vblank, the rest wait for the next */
+#define DMA_BUDGET 4096
+
+/* a transfer waiting for vblank */
+struct DmaTransfer {
+    void* dest;
+    const void* source;
+
+    /* bytes left to copy, a multiple of 4 */
+    int bytes;
+    int priority;
+
+    /* set to 0 once the whole transfer is done, may be null */
+    volatile int* done;
+};
+
+struct DmaTransfer dma_queue[DMA_QUEUE_SIZE];
+volatile int dma_queue_count = 0;
+
+/* the transfers for the last vblank */
+struct DmaStats {
+    /* bytes moved */
+    int bytes;
+
+    /* transfers finished */
+    int transfers;
+
+    /* transfers left over for the next vblank */
+    int deferred;
+};
+struct DmaStats dma_stats;
+
+/* queue a copy of some bytes (a multiple of 4) for the next vblank,
+ * returns 0 if the queue is full */
+int dma_queue_add(void* dest, const void* source, int bytes, int priority,
+        volatile int* done) {
+    /* keep the vblank handler out while the queue changes, and put
+     * interrupts back how they were, off if the caller had them off */
+    unsigned short enabled = *interrupt_enable;
+    *interrupt_enable = 0;
+    if (dma_queue_count == DMA_QUEUE_SIZE) {
+        *interrupt_enable = enabled;
+        return 0;
+    }
+    struct DmaTransfer* t = &dma_queue[dma_queue_count++];
+    t->dest = dest;
+    t->source = source;
+    t->bytes = bytes;
+    t->priority = priority;
+    t->done = done;
+    *interrupt_enable = enabled;
+    return 1;
+}
+
+/* run the queue in priority order until the budget runs out, a transfer
+ * bigger than what is left is split and the rest goes next vblank - one
+ * that isn't word aligned goes by 16 bit DMA rather than being misread */
+void dma_queue_vblank() {
+    int budget = DMA_BUDGET;
+    dma_stats.bytes = 0;
+    dma_stats.transfers = 0;
+
+    for (int p = 0; p < DMA_PRIORITIES && budget > 0; p++) {
+        for (int i = 0; i < dma_queue_count && budget > 0; i++) {
+            struct DmaTransfer* t = &dma_queue[i];
+            if (t->priority != p) {
+                continue;
+            }
+            int bytes = t->bytes < budget ? t->bytes : budget & ~3;
+            if (bytes == 0) {
+                budget = 0;
+                break;
+            }
+            if (((unsigned int) t->dest | (unsigned int) t->source | bytes) & 3) {
+                memcpy16_dma(t->dest, (unsigned short*) t->source, bytes >> 1);
+            } else {
+                memcpy32_dma(t->dest, t->source, bytes >> 2);
+            }
+            t->dest = (char*) t->dest + bytes;
+            t->source = (const char*) t->source + bytes;
+            t->bytes -= bytes;
+            budget -= bytes;
+            dma_stats.bytes += bytes;
+            if (t->bytes == 0) {
+                dma_stats.transfers++;
+                if (t->done) {
+                    *t->done = 0;
+                }
+            }
+        }
+    }
+
+    /* drop the finished transfers, keeping the order of the rest */
+    int kept = 0;
+    for (int i = 0; i < dma_queue_count; i++) {
+        if (dma_queue[i].bytes > 0) {
+            dma_queue[kept++] = dma_queue[i];
+        }
+    }
+    dma_queue_count = kept;
+    dma_stats.deferred = kept;
+}
 
 /* a sprite is a moveable image on the screen */
 struct Sprite {
@@ -139,23 +299,6 @@ struct Player {
     int isAlive;
 
     int isExploding;
-
-    int explosionTimer;
-};
-
-/* used for numbers*/
-struct Number{
-    struct Sprite* sprite;
-    int x,y;
-};
-
-struct Score{
-    struct Sprite* sprite;
-    int x,y;
-    struct Sprite* ones;
-    struct Sprite* tens;
-    struct Sprite* hunds;
-    struct Sprite* thous;
 };
 
 /* a struct for an enemies's logic and behavior */
@@ -166,7 +309,12 @@ struct Enemy {
     /* the x and y postion in pixels */
     int x, y;
 
-    /* the koopa's y velocity in 1/256 pixels/second */
+    /* the position in 1/256 pixels, for a diver which moves by fractions
+     * of a pixel a frame, x and y are the whole pixels of it */
+    int fx, fy;
+
+    /* the velocity in 1/256 pixels a frame */
+    int xvel;
     int yvel;
 
     /* which frame of the animation he is on */
@@ -192,14 +340,18 @@ struct Enemy {
 
     /*whether the enemy is currently explosing*/ 
     int isExploding;
-    
-    /*for explosion animation*/
-    int explosionTimer;
 
-    /*ogiginal Offset for this enemy. Use this to revert back to original image aftger explosoin */ 
-    int ogOffset; 
+    /* which archetype in enemy_types this enemy is, set when it spawns */
+    int type;
+
+    /* the heading its sprite is turned to, for the diving behavior */
+    int heading;
 };
 
+/* the enemies are one pool whatever their archetype, each formation
+ * spawns the ones it needs from the start of it - the biggest takes 27 */
+#define NUM_ENEMIES 27
+
 /* used for Bullets*/
 struct Bullet{
     struct Sprite* sprite;
@@ -211,9 +363,10 @@ struct Bullet{
 };
 
 
-/* array of all the sprites available on the GBA */
-struct Sprite sprites[NUM_SPRITES];
+/* array of all the sprites available on the GBA, then the objects */
+struct Sprite sprites[NUM_OBJECTS] __attribute__((aligned(4)));
 int next_sprite_index = 0;
+int next_object_index = NUM_SPRITES;
 
 /* the different sizes of sprites which are possible */
 enum SpriteSize {
@@ -231,13 +384,428 @@ enum SpriteSize {
     SIZE_32_64
 };
 
+/* one frame of an animation, the tile and palette bank to show and for
+ * how many frames */
+struct AnimFrame {
+    unsigned short tile;
+    unsigned char palette;
+    unsigned char duration;
+};
+
+/* whether a clip starts over or stops on its last frame */
+#define ANIM_LOOP 0
+#define ANIM_ONCE 1
 
-/* function to initialize a sprite with its properties, and return a pointer */
-struct Sprite* sprite_init(int x, int y, enum SpriteSize size,
-    int horizontal_flip, int vertical_flip, int tile_index, int priority) {
+/* an animation clip is a run of frames kept in ROM */
+struct AnimClip {
+    const struct AnimFrame* frames;
+    int count;
+    int flags;
+};
+
+/* the animation clips used by the game */
+const struct AnimFrame boss_idle_frames[] = { {TILE_BOSS, PAL_BOSS, 1} };
+const struct AnimFrame enemy1_idle_frames[] = { {TILE_ENEMY1, PAL_ENEMY1, 1} };
+const struct AnimFrame enemy2_idle_frames[] = { {TILE_ENEMY2, PAL_ENEMY2, 1} };
+const struct AnimFrame explosion_frames[] = {
+    {TILE_EXPLOSION1, PAL_EXPLOSION1, 15}, {TILE_EXPLOSION2, PAL_EXPLOSION2, 15}
+};
+const struct AnimFrame player_death_frames[] = {
+    {TILE_PEX1, PAL_PEX1, 20},
+    {TILE_EXPLOSION2, PAL_EXPLOSION2, 10}, {TILE_EXPLOSION1, PAL_EXPLOSION1, 10}
+};
+
+const struct AnimClip boss_idle = { boss_idle_frames, 1, ANIM_LOOP };
+const struct AnimClip enemy1_idle = { enemy1_idle_frames, 1, ANIM_LOOP };
+const struct AnimClip enemy2_idle = { enemy2_idle_frames, 1, ANIM_LOOP };
+const struct AnimClip explosion = { explosion_frames, 2, ANIM_ONCE };
+const struct AnimClip player_death = { player_death_frames, 4, ANIM_ONCE };
+
+/* the animation state of each sprite, indexed the same as sprites - word
+ * aligned so snapshots can copy them whole */
+const struct AnimClip* anim_clip[NUM_OBJECTS];
+unsigned char anim_frame[NUM_OBJECTS] __attribute__((aligned(4)));
+unsigned short anim_timer[NUM_OBJECTS] __attribute__((aligned(4)));
+
+/* the sprites with a clip to tick, and where each one sits in that list */
+unsigned char anim_active[NUM_OBJECTS] __attribute__((aligned(4)));
+unsigned char anim_slot[NUM_OBJECTS] __attribute__((aligned(4)));
+int anim_count = 0;
+
+/* the most particles that can be alive at once, more than there are
+ * hardware sprites since the multiplexer reuses them down the screen */
+#define NUM_PARTICLES 160
+
+/* particle state, one array per field - positions and velocities are
+ * 8.8 fixed point, lifetimes are in frames */
+int particle_x[NUM_PARTICLES];
+int particle_y[NUM_PARTICLES];
+short particle_dx[NUM_PARTICLES];
+short particle_dy[NUM_PARTICLES];
+unsigned char particle_life[NUM_PARTICLES];
+unsigned short particle_tile[NUM_PARTICLES];   /* tile | palette bank << 12 */
+short particle_frame[NUM_PARTICLES];           /* the cached frame it is part of */
+int particle_count = 0;
+
+/* particle counts for the last frame */
+struct ParticleStats {
+    /* particles alive */
+    int active;
+
+    /* particles that got a sprite */
+    int drawn;
+
+    /* particles not shown, either the pool or the sprites ran out */
+    int dropped;
+};
+struct ParticleStats particle_stats;
+
+/* particles turned away by a full pool since the last draw */
+int particle_rejected = 0;
+
+/* the sprite multiplexer shows more objects than there are hardware
+ * sprites by reusing the free ones, past next_sprite_index, down the
+ * screen - they are split into two sets and the screen into bands of
+ * MUX_BAND_LINES, objects go in the band their top is in, even bands use
+ * the first set and odd bands the second, the vblank writes bands 0 and 1
+ * and a vcount interrupt just before each later band rewrites the set it
+ * uses, which the band two up has finished with - so objects can be at
+ * most a band tall */
+#define MUX_BAND_LINES 32
+#define MUX_BANDS (HEIGHT / MUX_BAND_LINES)
+#define MUX_OBJECTS 192
+
+/* what added an object, so the stats can tell them apart */
+#define MUX_SPRITE 0
+#define MUX_PARTICLE 1
+#define MUX_SOURCES 2
+
+/* the objects added this frame and where each came from, and those turned
+ * away for a full list by source */
+struct Sprite mux_objects[MUX_OBJECTS];
+unsigned char mux_source[MUX_OBJECTS];
+int mux_count = 0;
+int mux_rejected[MUX_SOURCES];
+
+/* each band's set for the interrupts to write into OAM, double buffered
+ * like the scanline tables along with where the sets were and the last
+ * band with anything in it */
+struct Sprite mux_tables[2][MUX_BANDS][NUM_SPRITES / 2] __attribute__((aligned(4)));
+int mux_base[2], mux_half[2], mux_last[2];
+volatile int mux_front = 0;
+volatile int mux_ready = 0;
+
+/* the band the next vcount interrupt writes */
+volatile int mux_band;
+
+/* the multiplexer's counts for the last frame */
+struct MuxStats {
+    /* objects added */
+    int objects;
+
+    /* bands with at least one object */
+    int bands;
+
+    /* objects given a sprite, by source */
+    int shown[MUX_SOURCES];
+
+    /* objects not shown because their band's set was full, they were too
+     * tall, or there were more than MUX_OBJECTS, by source */
+    int dropped[MUX_SOURCES];
+};
+struct MuxStats mux_stats;
+
+void anim_play(struct Sprite* sprite, const struct AnimClip* clip);
+
+/* indices of the enemy archetypes in enemy_types */
+#define ENEMY_BOSS 0
+#define ENEMY_1 1
+#define ENEMY_2 2
+#define NUM_ENEMY_TYPES 3
+
+/* the stats shared by every enemy of one kind */
+struct EnemyType {
+    /* points for killing one - must stay the first member since
+     * increaseScore in functions.s loads it from the start of the entry */
+    int score;
+
+    /* the first tile of its image, its palette bank and the sprite size -
+     * a palette swapped variant is the same tile with another bank */
+    int tile;
+    int palette;
+    enum SpriteSize size;
+
+    /* how far a bullet's x can be left of the enemy's x, right of it,
+     * and below its y and still hit */
+    int hit_left, hit_right, hit_bottom;
 
-    /* grab the next index */
-    int index = next_sprite_index++;
+    /* health on spawning, each bullet takes 10 */
+    int health;
+
+    /* the clips played while it flies and when it dies */
+    const struct AnimClip* idle;
+    const struct AnimClip* death;
+
+    /* the number of frames to wait between steps */
+    int move_delay;
+
+    /* what the enemy does on each of its steps */
+    void (*behavior)(struct Enemy* enemy, struct Player* player);
+};
+_Static_assert(offsetof(struct EnemyType, score) == 0,
+        "increaseScore in functions.s loads the score from the start of the entry");
+
+void enemy_descend(struct Enemy* enemy, struct Player* player);
+void enemy_dive(struct Enemy* enemy, struct Player* player);
+
+/* the table of archetypes, indexed by ENEMY_BOSS, ENEMY_1... */
+const struct EnemyType enemy_types[NUM_ENEMY_TYPES] = {
+    /* score  tile         palette     size        hitbox    health idle          death       delay behavior */
+    {  350,   TILE_BOSS,   PAL_BOSS,   SIZE_16_16, 4, 12, 12,  50,    &boss_idle,   &explosion, 15,   enemy_descend },
+    {  15,    TILE_ENEMY1, PAL_ENEMY1, SIZE_16_16, 8, 12, 12,  10,    &enemy1_idle, &explosion, 15,   enemy_descend },
+    {  20,    TILE_ENEMY2, PAL_ENEMY2, SIZE_16_16, 4, 12, 12,  20,    &enemy2_idle, &explosion, 1,    enemy_dive },
+};
+
+/*declaration of increaseScore*/
+int increaseScore(int score, const struct EnemyType* type);
+
+
+/* the sprites of the sheet with more colors than a palette bank are
+ * 256 color and come first, this is whether a sheet tile is one of them */
+#define SPRITE_8BPP(tile) ((tile) < Sprites_8bpp_tiles)
+
+/* the color mode bit of attribute 0 for a sheet tile, 0:16, 1:256 */
+#define SPRITE_COLOR_MODE(tile) (SPRITE_8BPP(tile) << 13)
+
+/* the number of tile index units in one 8x8 tile at a sheet tile */
+#define SPRITE_TILE_STEP(tile) (SPRITE_8BPP(tile) ? 2 : 1)
+
+/* sprite tiles are streamed into OBJ VRAM as they are needed - VRAM is cut
+ * into slots of 4 tile index units, a frame takes a run of slots, and is
+ * looked up by its first tile in the sheet, so a frame must always be
+ * asked for with the same size */
+#define VRAM_SLOT_UNITS 4
+#define VRAM_SLOTS (1024 / VRAM_SLOT_UNITS)
+#define SHEET_UNITS (Sprites_data_bytes / 32)
+
+/* each slot's frame, the first slot of it or -1 if free, and on that first
+ * slot the sheet tile, the slots taken, the sprites using it and when it
+ * was last asked for */
+short vram_head[VRAM_SLOTS];
+short vram_tile[VRAM_SLOTS];
+unsigned char vram_length[VRAM_SLOTS];
+unsigned short vram_refs[VRAM_SLOTS];
+unsigned int vram_used[VRAM_SLOTS];
+unsigned int vram_clock;
+
+/* set on a frame's first slot while its upload waits for vblank */
+volatile int vram_pending[VRAM_SLOTS];
+
+/* the first slot of the frame at each sheet tile, or -1 */
+short vram_index[SHEET_UNITS];
+
+/* the cache's counts since the last reset */
+struct VramStats {
+    /* frames that were already resident */
+    int hits;
+
+    /* frames which had to be uploaded */
+    int misses;
+
+    /* unused frames thrown out to make room */
+    int evictions;
+
+    /* frames that didn't fit because everything was in use */
+    int full;
+};
+struct VramStats vram_stats;
+
+/* the tile index units of each sprite size at 4bpp, in enum order */
+const unsigned char size_units[] = { 1, 4, 16, 64, 2, 4, 8, 32, 2, 4, 8, 32 };
+
+/* the frame each sprite is showing and its size in 4bpp units, and the
+ * tile of the sheet it wants (-1 if none), which is what a snapshot keeps */
+short sprite_frame[NUM_OBJECTS];
+unsigned char sprite_units[NUM_OBJECTS];
+short sprite_tile[NUM_OBJECTS] __attribute__((aligned(4)));
+
+/* the frame each sprite switches to once its upload has landed (-1 if
+ * none) and the palette bank it switches to with it, and how many sprites
+ * are waiting */
+short sprite_next[NUM_OBJECTS];
+unsigned char sprite_next_palette[NUM_OBJECTS];
+int sprite_waiting = 0;
+
+/* empty the cache, nothing is resident afterwards */
+void vram_reset() {
+    for (int i = 0; i < VRAM_SLOTS; i++) {
+        vram_head[i] = -1;
+        vram_pending[i] = 0;
+    }
+    for (int i = 0; i < SHEET_UNITS; i++) {
+        vram_index[i] = -1;
+    }
+    for (int i = 0; i < NUM_OBJECTS; i++) {
+        sprite_frame[i] = -1;
+        sprite_tile[i] = -1;
+        sprite_next[i] = -1;
+    }
+    sprite_waiting = 0;
+    vram_clock = 0;
+    vram_stats.hits = 0;
+    vram_stats.misses = 0;
+    vram_stats.evictions = 0;
+    vram_stats.full = 0;
+}
+
+/* throw a frame out of the cache */
+void vram_evict(int head) {
+    vram_index[vram_tile[head]] = -1;
+    for (int i = 0; i < vram_length[head]; i++) {
+        vram_head[head + i] = -1;
+    }
+    vram_stats.evictions++;
+}
+
+/* make a frame of the sheet resident and take a reference to it, returns
+ * its first slot or -1 if every slot is in use - a new frame goes in the
+ * run of slots whose frames were used longest ago and is uploaded by the
+ * vblank DMA queue, pending until it lands, or copied now if the queue is
+ * full */
+int vram_acquire(int tile, int units) {
+    int head = vram_index[tile];
+    if (head >= 0) {
+        vram_refs[head]++;
+        vram_used[head] = ++vram_clock;
+        vram_stats.hits++;
+        return head;
+    }
+    vram_stats.misses++;
+
+    /* free slots count as used at time 0, so they go first */
+    int length = (units + VRAM_SLOT_UNITS - 1) / VRAM_SLOT_UNITS;
+    int best = -1;
+    unsigned int best_age = 0;
+    for (int start = 0; start + length <= VRAM_SLOTS; start++) {
+        unsigned int age = 0;
+        int usable = 1;
+        for (int i = start; i < start + length; i++) {
+            int h = vram_head[i];
+            if (h >= 0) {
+                /* an upload on its way has to land before the slots are reused */
+                if (vram_refs[h] || vram_pending[h]) {
+                    usable = 0;
+                    break;
+                }
+                if (vram_used[h] > age) {
+                    age = vram_used[h];
+                }
+            }
+        }
+        if (usable && (best < 0 || age < best_age)) {
+            best = start;
+            best_age = age;
+            if (age == 0) {
+                break;
+            }
+        }
+    }
+    if (best < 0) {
+        vram_stats.full++;
+        return -1;
+    }
+
+    for (int i = best; i < best + length; i++) {
+        if (vram_head[i] >= 0) {
+            vram_evict(vram_head[i]);
+        }
+    }
+    for (int i = best; i < best + length; i++) {
+        vram_head[i] = best;
+    }
+    vram_tile[best] = tile;
+    vram_length[best] = length;
+    vram_refs[best] = 1;
+    vram_used[best] = ++vram_clock;
+    vram_index[tile] = best;
+
+    void* dest = (void*) (sprite_image_memory + best * VRAM_SLOT_UNITS * 16);
+    const void* source = Sprites_data + tile * 32;
+    vram_pending[best] = 1;
+    if (!dma_queue_add(dest, source, units * 32, DMA_PRIORITY_TILES, &vram_pending[best])) {
+        memcpy32(dest, source, units * 32);
+        vram_pending[best] = 0;
+    }
+    return best;
+}
+
+/* drop a reference to a frame, it stays resident until it is evicted */
+void vram_release(int head) {
+    if (head >= 0 && vram_refs[head]) {
+        vram_refs[head]--;
+    }
+}
+
+void sprite_set_offset(struct Sprite* sprite, int offset);
+
+/* point a sprite at a resident frame, switching it between 16 and 256
+ * colors if the frame's sprite is the other kind */
+void sprite_show_frame(struct Sprite* sprite, int head) {
+    sprite_set_offset(sprite, head * VRAM_SLOT_UNITS);
+    sprite->attribute0 = (sprite->attribute0 & ~0x2000) | SPRITE_COLOR_MODE(vram_tile[head]);
+}
+
+/* show a frame of the sheet on a sprite, keeping the old one if the new one
+ * can't be made resident - a frame still on its way to VRAM is switched to
+ * by sprite_land_frames once it is there, and the old one shows till then */
+void sprite_set_frame(struct Sprite* sprite, int tile) {
+    int index = sprite - sprites;
+    int next = sprite_next[index];
+    int old = next >= 0 ? next : sprite_frame[index];
+    if (old >= 0 && vram_tile[old] == tile) {
+        return;
+    }
+    int head = vram_acquire(tile, sprite_units[index] * SPRITE_TILE_STEP(tile));
+    if (head < 0) {
+        return;
+    }
+    sprite_tile[index] = tile;
+    if (next >= 0) {
+        vram_release(next);
+        sprite_next[index] = -1;
+        sprite_waiting--;
+    }
+    if (vram_pending[head] && sprite_frame[index] >= 0) {
+        sprite_next[index] = head;
+        sprite_next_palette[index] = sprite->attribute2 >> 12;
+        sprite_waiting++;
+        return;
+    }
+    vram_release(sprite_frame[index]);
+    sprite_frame[index] = head;
+    sprite_show_frame(sprite, head);
+}
+
+/* switch the sprites whose new frames have landed over to them */
+void sprite_land_frames() {
+    for (int i = 0; i < NUM_OBJECTS && sprite_waiting; i++) {
+        int next = sprite_next[i];
+        if (next >= 0 && !vram_pending[next]) {
+            vram_release(sprite_frame[i]);
+            sprite_frame[i] = next;
+            sprite_next[i] = -1;
+            sprite_waiting--;
+            sprite_show_frame(&sprites[i], next);
+            sprites[i].attribute2 = (sprites[i].attribute2 & 0x0fff) |
+                (sprite_next_palette[i] << 12);
+        }
+    }
+}
+
+/* function to initialize a sprite with its properties, and return a pointer,
+ * the palette bank is ignored for a 256 color sprite */
+struct Sprite* sprite_setup(int index, int x, int y, enum SpriteSize size,
+    int horizontal_flip, int vertical_flip, int tile_index, int palette, int priority) {
 
     /* tile_index=1; */
 
@@ -266,7 +834,7 @@ struct Sprite* sprite_init(int x, int y, enum SpriteSize size,
         (0 << 8) |          /* rendering mode */
         (0 << 10) |         /* gfx mode */
         (0 << 12) |         /* mosaic */
-        (1 << 13) |         /* color mode, 0:16, 1:256 */
+        SPRITE_COLOR_MODE(tile_index) | /* color mode, 0:16, 1:256 */
         (shape_bits << 14); /* shape */
 
     /* set up the second attribute */
@@ -276,15 +844,34 @@ struct Sprite* sprite_init(int x, int y, enum SpriteSize size,
         (v << 13) |         /* vertical flip flag */
         (size_bits << 14);  /* size */
 
-    /* setup the second attribute */
-    sprites[index].attribute2 = tile_index |   // tile index */
+    /* setup the second attribute, the tile is filled in from the cache */
+    sprites[index].attribute2 = 0 |            // tile index */
         (priority << 10) | // priority */
-        (0 << 12);         // palette bank (only 16 color)*/
+        (palette << 12);   // palette bank (only 16 color)*/
+
+    sprite_frame[index] = -1;
+    sprite_next[index] = -1;
+    sprite_units[index] = size_units[size];
+    sprite_set_frame(&sprites[index], tile_index);
 
     /* return pointer to this sprite */
     return &sprites[index];
 }
 
+/* set up the next hardware sprite, which keeps its OAM slot */
+struct Sprite* sprite_init(int x, int y, enum SpriteSize size,
+    int horizontal_flip, int vertical_flip, int tile_index, int palette, int priority) {
+    return sprite_setup(next_sprite_index++, x, y, size, horizontal_flip, vertical_flip,
+            tile_index, palette, priority);
+}
+
+/* set up the next object, which the multiplexer draws */
+struct Sprite* object_init(int x, int y, enum SpriteSize size,
+    int horizontal_flip, int vertical_flip, int tile_index, int palette, int priority) {
+    return sprite_setup(next_object_index++, x, y, size, horizontal_flip, vertical_flip,
+            tile_index, palette, priority);
+}
+
 /* initialize the koopa */
 void player_init(struct Player* koopa) {
     koopa->x = 112;
@@ -296,14 +883,14 @@ void player_init(struct Player* koopa) {
     koopa->counter = 0;
     koopa->animation_delay = 8;
     koopa->isExploding = 0;
-    koopa->explosionTimer = 50;
     koopa->isAlive = 1;
     koopa->sprite = sprite_init(koopa->x, koopa->y, SIZE_16_16, 0, 0, 
-            koopa->frame, 0);
+            TILE_PLAYER, PAL_PLAYER, 0);
 }
 
-/* initialize an enemy */
-void enemy_init(struct Enemy* koopa, int x, int y,int offset) {
+/* initialize an enemy of the given archetype */
+void enemy_init(struct Enemy* koopa, int x, int y, int type) {
+    const struct EnemyType* t = &enemy_types[type];
     koopa->x = x;
     koopa->y = y;
     koopa->yvel = 0;
@@ -311,68 +898,158 @@ void enemy_init(struct Enemy* koopa, int x, int y,int offset) {
     koopa->frame = 0;
     koopa->move = 0;
     koopa->counter = 0;
-    koopa->animation_delay = 15;
+    koopa->animation_delay = t->move_delay;
     koopa->health = 0;
     koopa->isAlive = 0;
     koopa->isExploding = 0;
-    koopa->explosionTimer = 30;
-    koopa->ogOffset = offset; 
-    koopa->sprite = sprite_init(koopa->x, koopa->y, SIZE_16_16, 0, 0, 
-            offset, 0);
-}
-
-void num_init(struct Number* num,int x, int y, int offset){
-    num->x=x;
-    num->y=y;
-    num->sprite=sprite_init(num->x, num->y, SIZE_8_8, 0, 0, 
-            offset, 0);
+    koopa->type = type;
+    koopa->sprite = object_init(koopa->x, koopa->y, t->size, 0, 0, 
+            t->tile, t->palette, 0);
+    anim_play(koopa->sprite, t->idle);
 }
 
-void bullet_init(struct Bullet* num,int x, int y,int offset){
+void bullet_init(struct Bullet* num,int x, int y,int offset, int palette){
     num->x=x;
     num->y=y;
     num->active=0;
     num->yvel=0;  
-    num->sprite=sprite_init(num->x, num->y, SIZE_8_8, 0, 0, 
-            offset, 0);
+    num->sprite=object_init(num->x, num->y, SIZE_8_8, 0, 0, 
+            offset, palette, 0);
 }
 
 void init_bullets(struct Bullet pBullets[], int size){
     for( int i = 0; i < size; i++){
         struct Bullet pbullet;
-        bullet_init(&pbullet, WIDTH /2, 0, PlayerBullet); 
+        bullet_init(&pbullet, WIDTH /2, 0, TILE_PLAYERBULLET, PAL_PLAYERBULLET); 
         pBullets[i] = pbullet;  
     }
 } 
 
-void score_init(struct Score* num,int x, int y){
-    num->x=x;
-    num->y=y;
-    num->sprite=sprite_init(num->x, num->y, SIZE_32_8, 0, 0, 
-        SCORE, 0);
-    num->thous=sprite_init(num->x+32, num->y,SIZE_8_8, 0, 0, Zero, 0);
-    num->hunds=sprite_init(num->x+40, num->y,SIZE_8_8, 0, 0, Zero, 0);
-    num->tens=sprite_init(num->x+48, num->y,SIZE_8_8, 0, 0, Zero, 0);
-    num->ones=sprite_init(num->x+56, num->y,SIZE_8_8, 0, 0, Zero, 0);
+
+/* the height of a sprite from its shape and size bits */
+const unsigned char sprite_heights[3][4] = {
+    { 8, 16, 32, 64 },  /* square */
+    { 8, 8, 16, 32 },   /* wide */
+    { 16, 32, 32, 64 }, /* tall */
+};
+
+/* the width of a sprite from its shape and size bits */
+const unsigned char sprite_widths[3][4] = {
+    { 8, 16, 32, 64 },  /* square */
+    { 16, 32, 32, 64 }, /* wide */
+    { 8, 8, 16, 32 },   /* tall */
+};
+
+/* the most separate OAM copies queued in a frame, past this the skipped
+ * sprites in between are just copied again */
+#define OAM_RUNS 4
+
+/* whether each sprite was culled in the last OAM copy, and whether the
+ * next copy has to send everything */
+unsigned char sprite_culled[NUM_SPRITES];
+int oam_fresh = 1;
+
+/* the culling counts for the last frame */
+struct CullStats {
+    /* sprites on the screen */
+    int visible;
+
+    /* sprites turned off for being off the screen */
+    int culled;
+
+    /* culled sprites not copied to OAM since they were culled already */
+    int skipped;
+
+    /* OAM copies queued */
+    int runs;
+};
+struct CullStats cull_stats;
+
+/* queue one run of sprites to be copied into OAM, returns 0 if the queue
+ * is full */
+int oam_run(int start, int end) {
+    if (!dma_queue_add((void*) (sprite_attribute_memory + start * 4), &sprites[start],
+            (end - start) * sizeof(struct Sprite), DMA_PRIORITY_OAM, 0)) {
+        return 0;
+    }
+    cull_stats.runs++;
+    return 1;
 }
 
-/* update all of the sprites on the screen */
+/* turn off the sprites which are entirely off the 240x160 screen with the
+ * disable bit of attribute 0, and queue the rest of OAM for the next
+ * vblank, leaving out sprites that were already off last time - affine
+ * sprites are left alone, since bit 9 is their double size flag, and the
+ * multiplexer's sprites past next_sprite_index are always copied - if a
+ * run doesn't fit in the queue, the next copy sends everything, since the
+ * culled sprites it skips may not have made it */
 void sprite_update_all() {
-    /* copy them all over */
-    memcpy16_dma((unsigned short*) sprite_attribute_memory, 
-            (unsigned short*) sprites, NUM_SPRITES * 4);
+    int start = 0;
+    int queued = 1;
+    cull_stats.visible = 0;
+    cull_stats.culled = 0;
+    cull_stats.skipped = 0;
+    cull_stats.runs = 0;
+
+    for (int i = 0; i < next_sprite_index; i++) {
+        struct Sprite* sprite = &sprites[i];
+        int hidden = 0;
+        if (!(sprite->attribute0 & 0x0100)) {
+            int shape = (sprite->attribute0 >> 14) & 3;
+            int size = sprite->attribute1 >> 14;
+            int y = sprite->attribute0 & 0xff;
+            int x = sprite->attribute1 & 0x1ff;
+
+            /* positions wrap, so a sprite near the end is partly on the top
+             * or left edge */
+            hidden = !(y < HEIGHT || y + sprite_heights[shape][size] > 256) ||
+                !(x < WIDTH || x + sprite_widths[shape][size] > 512);
+            if (hidden) {
+                sprite->attribute0 |= 0x0200;
+                cull_stats.culled++;
+            } else {
+                sprite->attribute0 &= ~0x0200;
+            }
+        }
+        cull_stats.visible += !hidden;
+
+        int skip = hidden && sprite_culled[i] && !oam_fresh;
+        sprite_culled[i] = hidden;
+        if (!skip) {
+            if (start < 0) {
+                start = i;
+            }
+        } else if (start < 0) {
+            cull_stats.skipped++;
+        } else if (cull_stats.runs < OAM_RUNS - 1) {
+            queued &= oam_run(start, i);
+            start = -1;
+            cull_stats.skipped++;
+        }
+    }
+
+    /* copy them all over in the next vblank */
+    queued &= oam_run(start < 0 ? next_sprite_index : start, NUM_SPRITES);
+    oam_fresh = !queued;
 }
 
 /* setup all sprites */
 void sprite_clear() {
-    /* clear the index counter */
+    /* clear the index counters */
     next_sprite_index = 0;
+    next_object_index = NUM_SPRITES;
 
     /* move all sprites offscreen to hide them */
-    for(int i = 0; i < NUM_SPRITES; i++) {
+    for(int i = 0; i < NUM_OBJECTS; i++) {
         sprites[i].attribute0 = HEIGHT;
         sprites[i].attribute1 = WIDTH;
+        anim_clip[i] = 0;
     }
+    anim_count = 0;
+    particle_count = 0;
+    mux_count = 0;
+    oam_fresh = 1;
+    vram_reset();
 }
 
 /* set a sprite postion */
@@ -433,305 +1110,510 @@ void sprite_set_offset(struct Sprite* sprite, int offset) {
     sprite->attribute2 |= (offset & 0x03ff);
 }
 
-/* setup the sprite image and palette */
-void setup_sprite_image() {
-    /* load the palette from the image into palette memory size=45*/
-    memcpy16_dma((unsigned short*) sprite_palette, 
-            (unsigned short*) Merged_palette, PALETTE_SIZE);
+/* change the palette bank of a 16 color sprite, along with its frame if
+ * that is still on its way */
+void sprite_set_palette(struct Sprite* sprite, int palette) {
+    int index = sprite - sprites;
+    if (sprite_next[index] >= 0) {
+        sprite_next_palette[index] = palette;
+        return;
+    }
+    sprite->attribute2 = (sprite->attribute2 & 0x0fff) | (palette << 12);
+}
+
+/* sprites can be rotated to one of 32 headings, heading 0 is the way the
+ * images face (down) and they go round counterclockwise - each heading has
+ * its own OAM affine group, so every sprite on a heading shares it */
+#define NUM_HEADINGS 32
+
+/* the affine matrix of each heading in 8.8, pa pb pc pd, which maps the
+ * screen back onto the image - -pb and pd are also the heading's direction */
+const short heading_affine[NUM_HEADINGS][4] = {
+    {256, 0, 0, 256}, {251, -50, 50, 251}, {237, -98, 98, 237}, {213, -142, 142, 213},
+    {181, -181, 181, 181}, {142, -213, 213, 142}, {98, -237, 237, 98}, {50, -251, 251, 50},
+    {0, -256, 256, 0}, {-50, -251, 251, -50}, {-98, -237, 237, -98}, {-142, -213, 213, -142},
+    {-181, -181, 181, -181}, {-213, -142, 142, -213}, {-237, -98, 98, -237}, {-251, -50, 50, -251},
+    {-256, 0, 0, -256}, {-251, 50, -50, -251}, {-237, 98, -98, -237}, {-213, 142, -142, -213},
+    {-181, 181, -181, -181}, {-142, 213, -213, -142}, {-98, 237, -237, -98}, {-50, 251, -251, -50},
+    {0, 256, -256, 0}, {50, 251, -251, 50}, {98, 237, -237, 98}, {142, 213, -213, 142},
+    {181, 181, -181, 181}, {213, 142, -142, 213}, {237, 98, -98, 237}, {251, 50, -50, 251},
+};
+
+/* write the heading matrices into the affine groups, which live in the
+ * fourth attribute of each run of four sprites and go over with the rest
+ * of OAM every vblank */
+void affine_setup() {
+    for (int h = 0; h < NUM_HEADINGS; h++) {
+        for (int i = 0; i < 4; i++) {
+            sprites[h * 4 + i].attribute3 = heading_affine[h][i];
+        }
+    }
+}
 
-    /* load the image into sprite image memory */
-    memcpy16_dma((unsigned short*) sprite_image_memory, 
-    (unsigned short*) Merged_data, (Merged_width * Merged_height) / 2);
+/* turn a sprite to a heading with its affine group, clearing bit 9 which
+ * culling may have left set and which would now mean double size */
+void sprite_rotate(struct Sprite* sprite, int heading) {
+    sprite->attribute0 = (sprite->attribute0 & ~0x0200) | 0x0100;
+    sprite->attribute1 = (sprite->attribute1 & 0xc1ff) | ((heading & (NUM_HEADINGS - 1)) << 9);
 }
 
-void initializeAll_Enemy1(struct Enemy enemy1Array[], int size) {
-    for (int i = 0; i < size; i++) {
-        struct Enemy enemy1;
-        enemy_init(&enemy1,WIDTH,HEIGHT,Enemy1);
-        enemy1Array[i] = enemy1;
+/* the heading nearest a direction, the one whose direction has the most
+ * in common with it */
+int heading_toward(int dx, int dy) {
+    int nearest = 0;
+    int most = dy * heading_affine[0][3];
+    for (int h = 1; h < NUM_HEADINGS; h++) {
+        int along = -dx * heading_affine[h][1] + dy * heading_affine[h][3];
+        if (along > most) {
+            most = along;
+            nearest = h;
+        }
     }
+    return nearest;
 }
 
-void initializeAll_Enemy2(struct Enemy enemy2Array[], int size) {
-    for (int i = 0; i < size; i++) {
-        struct Enemy enemy2;
-        enemy_init(&enemy2,WIDTH,HEIGHT,Enemy2);
-        enemy2Array[i] = enemy2;
+/* go back to drawing a sprite the normal way */
+void sprite_unrotate(struct Sprite* sprite) {
+    sprite->attribute0 &= ~0x0100;
+    sprite->attribute1 &= 0xc1ff;
+}
+
+/* take a sprite off the active list */
+void anim_remove(int index) {
+    int last = anim_active[--anim_count];
+    anim_active[anim_slot[index]] = last;
+    anim_slot[last] = anim_slot[index];
+    anim_clip[index] = 0;
+}
+
+/* start a clip on a sprite from its first frame */
+void anim_play(struct Sprite* sprite, const struct AnimClip* clip) {
+    int index = sprite - sprites;
+    int playing = anim_clip[index] != 0;
+
+    anim_frame[index] = 0;
+    anim_timer[index] = clip->frames[0].duration;
+    sprite_set_frame(sprite, clip->frames[0].tile);
+    sprite_set_palette(sprite, clip->frames[0].palette);
+
+    /* a single looping frame never changes, so there is nothing to tick */
+    if (clip->count == 1 && clip->flags == ANIM_LOOP) {
+        if (playing) {
+            anim_remove(index);
+        }
+        return;
+    }
+
+    anim_clip[index] = clip;
+    if (!playing) {
+        anim_slot[index] = anim_count;
+        anim_active[anim_count++] = index;
+    }
+}
+
+/* returns whether a sprite still has a clip running */
+int anim_playing(struct Sprite* sprite) {
+    return anim_clip[sprite - sprites] != 0;
+}
+
+/* advance every running clip by one frame, only touching a sprite's
+ * tile when its clip moves on to the next frame */
+void anim_update_all() {
+    int i = 0;
+    while (i < anim_count) {
+        int index = anim_active[i];
+        if (--anim_timer[index] == 0) {
+            const struct AnimClip* clip = anim_clip[index];
+            int frame = anim_frame[index] + 1;
+            if (frame == clip->count) {
+                if (clip->flags == ANIM_ONCE) {
+                    /* the last sprite moves into this spot, so don't advance */
+                    anim_remove(index);
+                    continue;
+                }
+                frame = 0;
+            }
+            anim_frame[index] = frame;
+            anim_timer[index] = clip->frames[frame].duration;
+            sprite_set_frame(&sprites[index], clip->frames[frame].tile);
+            sprite_set_palette(&sprites[index], clip->frames[frame].palette);
+        }
+        i++;
+    }
+}
+
+/* start a particle at a pixel position showing the tile offset tiles into
+ * a frame of the sheet units big at 4bpp, drops it if the pool is full or
+ * the frame can't be made resident */
+void particle_spawn(int x, int y, int dx, int dy, int life, int tile, int units,
+        int offset, int palette) {
+    if (particle_count == NUM_PARTICLES) {
+        particle_rejected++;
+        return;
+    }
+    int step = SPRITE_TILE_STEP(tile);
+    int head = vram_acquire(tile, units * step);
+    if (head < 0) {
+        particle_rejected++;
+        return;
+    }
+    int i = particle_count++;
+    particle_x[i] = x << 8;
+    particle_y[i] = y << 8;
+    particle_dx[i] = dx;
+    particle_dy[i] = dy;
+    particle_life[i] = life;
+    particle_tile[i] = (head * VRAM_SLOT_UNITS + offset * step) | (palette << 12);
+    particle_frame[i] = head;
+}
+
+/* the directions the four quarters of an explosion fly apart in */
+const short debris_dx[4] = { -0x100, 0x100, -0x100, 0x100 };
+const short debris_dy[4] = { -0x100, -0x100, 0x100, 0x100 };
+
+/* break a 16x16 explosion at x, y into four 8x8 pieces of debris */
+void particle_debris(int x, int y) {
+    for (int i = 0; i < 4; i++) {
+        /* each 8x8 quarter is one tile on */
+        particle_spawn(x + (i & 1) * 8, y + (i >> 1) * 8, debris_dx[i], debris_dy[i],
+                24, TILE_EXPLOSION1, 4, i, PAL_EXPLOSION1);
+    }
+}
+
+/* throw a couple of sparks off where a bullet hit */
+void particle_sparks(int x, int y) {
+    particle_spawn(x, y, -0x80, 0x100, 8, TILE_PLAYERBULLET, 1, 0, PAL_PLAYERBULLET);
+    particle_spawn(x, y, 0x80, 0x100, 8, TILE_PLAYERBULLET, 1, 0, PAL_PLAYERBULLET);
+}
+
+/* move every particle, and remove the ones that expire or leave the screen */
+void particle_update() {
+    int i = 0;
+    while (i < particle_count) {
+        particle_x[i] += particle_dx[i];
+        particle_y[i] += particle_dy[i];
+        int x = particle_x[i] >> 8;
+        int y = particle_y[i] >> 8;
+        if (--particle_life[i] == 0 || x < -8 || x >= WIDTH || y < -8 || y >= HEIGHT) {
+            /* move the last particle into this spot */
+            vram_release(particle_frame[i]);
+            int last = --particle_count;
+            particle_x[i] = particle_x[last];
+            particle_y[i] = particle_y[last];
+            particle_dx[i] = particle_dx[last];
+            particle_dy[i] = particle_dy[last];
+            particle_life[i] = particle_life[last];
+            particle_tile[i] = particle_tile[last];
+            particle_frame[i] = particle_frame[last];
+        } else {
+            i++;
+        }
+    }
+}
+
+/* add an object for the multiplexer to show this frame */
+void mux_add(int attribute0, int attribute1, int attribute2, int source) {
+    if (mux_count == MUX_OBJECTS) {
+        mux_rejected[source]++;
+        return;
+    }
+    mux_source[mux_count] = source;
+    struct Sprite* o = &mux_objects[mux_count++];
+    o->attribute0 = attribute0;
+    o->attribute1 = attribute1;
+    o->attribute2 = attribute2;
+}
+
+/* hide a multiplexed sprite, keeping the affine parameter in attribute 3 */
+void mux_hide(struct Sprite* sprite) {
+    sprite->attribute0 = HEIGHT;
+    sprite->attribute1 = WIDTH;
+}
+
+/* sort this frame's objects into bands in the back table, leaving out
+ * those off the screen */
+void mux_end() {
+    int back = mux_front ^ 1;
+    int base = next_sprite_index;
+    int half = (NUM_SPRITES - base) / 2;
+    int fill[MUX_BANDS] = { 0 };
+    int rejected = 0;
+    for (int i = 0; i < MUX_SOURCES; i++) {
+        mux_stats.shown[i] = 0;
+        mux_stats.dropped[i] = mux_rejected[i];
+        rejected += mux_rejected[i];
+        mux_rejected[i] = 0;
+    }
+
+    /* the vblank mustn't swap in a half built table */
+    mux_ready = 0;
+
+    for (int i = 0; i < mux_count; i++) {
+        struct Sprite* o = &mux_objects[i];
+        int height = sprite_heights[(o->attribute0 >> 14) & 3][o->attribute1 >> 14];
+        int top = o->attribute0 & 0xff;
+        if (top >= HEIGHT) {
+            top -= 256;
+        }
+        int width = sprite_widths[(o->attribute0 >> 14) & 3][o->attribute1 >> 14];
+        int left = o->attribute1 & 0x1ff;
+        if (left >= WIDTH) {
+            left -= 512;
+        }
+        if (top + height <= 0 || top >= HEIGHT || left + width <= 0 || left >= WIDTH) {
+            continue;
+        }
+        int band = top < 0 ? 0 : top / MUX_BAND_LINES;
+        if (height > MUX_BAND_LINES || fill[band] == half) {
+            mux_stats.dropped[mux_source[i]]++;
+            continue;
+        }
+        mux_stats.shown[mux_source[i]]++;
+
+        int slot = base + (band & 1) * half + fill[band];
+        struct Sprite* dest = &mux_tables[back][band][fill[band]];
+        dest->attribute0 = o->attribute0;
+        dest->attribute1 = o->attribute1;
+        dest->attribute2 = o->attribute2;
+        dest->attribute3 = sprites[slot].attribute3;
+        fill[band]++;
+    }
+
+    /* hide the rest of each band's set, and the odd sprite out */
+    int last = 0;
+    mux_stats.bands = 0;
+    for (int band = 0; band < MUX_BANDS; band++) {
+        for (int i = fill[band]; i < half; i++) {
+            int slot = base + (band & 1) * half + i;
+            mux_hide(&mux_tables[back][band][i]);
+            mux_tables[back][band][i].attribute3 = sprites[slot].attribute3;
+        }
+        if (fill[band]) {
+            mux_stats.bands++;
+            last = band;
+        }
     }
+    if (base + half * 2 < NUM_SPRITES) {
+        mux_hide(&sprites[NUM_SPRITES - 1]);
+    }
+
+    mux_base[back] = base;
+    mux_half[back] = half;
+    mux_last[back] = last;
+    mux_stats.objects = mux_count + rejected;
+    mux_count = 0;
+    mux_ready = 1;
+}
+
+/* point the vcount interrupt at the line before a band starts, or turn it
+ * off once the last band with objects is in */
+void mux_next(int band) {
+    mux_band = band;
+    if (band <= mux_last[mux_front]) {
+        int line = band * MUX_BAND_LINES - 2;
+        *display_interrupts = (*display_interrupts & 0x00df) | (line << 8) | 0x20;
+    } else {
+        *display_interrupts &= 0x00df;
+    }
+}
+
+/* write a band's set into OAM */
+void mux_write(int band) {
+    int front = mux_front;
+    int half = mux_half[front];
+    volatile unsigned short* dest = sprite_attribute_memory +
+        (mux_base[front] + (band & 1) * half) * 4;
+    memcpy32((void*) dest, mux_tables[front][band], half * sizeof(struct Sprite));
+}
+
+/* swap in the newest bands and write 0 and 1, after the queued OAM copy so
+ * they are there even if that copy has been put off */
+void mux_vblank() {
+    if (mux_ready) {
+        mux_front ^= 1;
+        mux_ready = 0;
+    }
+    mux_write(0);
+    mux_write(1);
+    mux_next(2);
+}
+
+/* write the next band's set into OAM, the band two up is done with it */
+void mux_vcount() {
+    mux_write(mux_band);
+    mux_next(mux_band + 1);
+}
+
+/* hand the objects and then the particles to the multiplexer - objects go
+ * first, so when a band is full it is particles that are dropped */
+void mux_draw() {
+    for (int i = NUM_SPRITES; i < next_object_index; i++) {
+        mux_add(sprites[i].attribute0, sprites[i].attribute1, sprites[i].attribute2,
+                MUX_SPRITE);
+    }
+    for (int i = 0; i < particle_count; i++) {
+        /* a particle shows up once its frame has landed */
+        if (vram_pending[particle_frame[i]]) {
+            continue;
+        }
+        mux_add(((particle_y[i] >> 8) & 0xff) |
+                SPRITE_COLOR_MODE(vram_tile[particle_frame[i]]),
+                (particle_x[i] >> 8) & 0x1ff, particle_tile[i], MUX_PARTICLE);
+    }
+    mux_end();
+
+    particle_stats.active = particle_count;
+    particle_stats.drawn = mux_stats.shown[MUX_PARTICLE];
+    particle_stats.dropped = mux_stats.dropped[MUX_PARTICLE] + particle_rejected;
+    particle_rejected = 0;
 }
 
-void initializeAll_Boss(struct Enemy bossArray[], int size) {
+/* make the pool's enemies, the sprite is set up once and takes on an
+ * archetype's frames when it spawns, so every archetype is the same size */
+void initializeAll_Enemies(struct Enemy enemies[], int size) {
     for (int i = 0; i < size; i++) {
-        struct Enemy boss;
-        enemy_init(&boss,WIDTH,HEIGHT,Boss);
-        bossArray[i] = boss;
+        enemy_init(&enemies[i], WIDTH, HEIGHT, ENEMY_1);
     }
 }
 
-void spawn_formation1(struct Enemy enemy1s[]) {
+/* bring an enemy into play as an archetype at a position, with its
+ * health and frames */
+void enemy_spawn(struct Enemy* enemy, int type, int x, int y) {
+    const struct EnemyType* t = &enemy_types[type];
+    enemy->type = type;
+    enemy->animation_delay = t->move_delay;
+    enemy->counter = 0;
+    anim_play(enemy->sprite, t->idle);
+    enemy->x = x;
+    enemy->y = y;
+    enemy->fx = x << 8;
+    enemy->fy = y << 8;
+    enemy->xvel = 0;
+    enemy->yvel = 0;
+    sprite_position(enemy->sprite, enemy->x, enemy->y);
+    sprite_unrotate(enemy->sprite);
+    enemy->heading = 0;
+    enemy->isAlive = 1;
+    enemy->health = t->health;
+}
+
+void spawn_formation1(struct Enemy enemies[]) {
     int xStart = 52;
     int xOffset = 60;
     for (int i = 0; i < 3; i++) {
-        enemy1s[i].x = xStart + (xOffset * i);
-        enemy1s[i].y = -16;
-        sprite_position(enemy1s[i].sprite,enemy1s[i].x,enemy1s[i].y);
-        enemy1s[i].isAlive = 1;
-        enemy1s[i].health = 10;
+        enemy_spawn(&enemies[i], ENEMY_1, xStart + (xOffset * i), -16);
     }
 }
 
-void spawn_formation2(struct Enemy enemy1s[]) {
+void spawn_formation2(struct Enemy enemies[]) {
     int xStart = 32;
     int xOffset = 32;
     for (int i = 0; i < 6; i++) {
-        enemy1s[i].x = xStart + (xOffset * i);
-        enemy1s[i].y = -16;
-        sprite_position(enemy1s[i].sprite,enemy1s[i].x,enemy1s[i].y);
-        enemy1s[i].isAlive = 1;
-        enemy1s[i].health = 10;
+        enemy_spawn(&enemies[i], ENEMY_1, xStart + (xOffset * i), -16);
     }
 }
 
-void spawn_formation3(struct Enemy enemy1s[]) {
+void spawn_formation3(struct Enemy enemies[]) {
     int r1_xStart = 40;
     int r1_xOffset = 36;
     for (int i = 0; i < 5; i++) {
-        enemy1s[i].x = r1_xStart + (r1_xOffset * i);
-        enemy1s[i].y = -28;
-        sprite_position(enemy1s[i].sprite,enemy1s[i].x,enemy1s[i].y);
-        enemy1s[i].isAlive = 1; 
-        enemy1s[i].health = 10;
+        enemy_spawn(&enemies[i], ENEMY_1, r1_xStart + (r1_xOffset * i), -28);
     }
     int r2_xStart = 58;
     int r2_xOffset = 36;
     for (int i = 5; i < 9; i++) {
-        enemy1s[i].x = r2_xStart + (r2_xOffset * (i - 5));
-        enemy1s[i].y = -16;
-        sprite_position(enemy1s[i].sprite,enemy1s[i].x,enemy1s[i].y);
-        enemy1s[i].isAlive = 1;
-        enemy1s[i].health = 10;
+        enemy_spawn(&enemies[i], ENEMY_1, r2_xStart + (r2_xOffset * (i - 5)), -16);
     } 
 }
 
-void spawn_formation4(struct Enemy enemy1s[], struct Enemy enemy2s[]) {
+void spawn_formation4(struct Enemy enemies[]) {
+    int n = 0;
     int xOffset = 28;
     int r1_xStart = 14;
     for (int i = 0; i < 8; i++) {
-        enemy1s[i].x = r1_xStart + (xOffset * i);
-        enemy1s[i].y = -28;
-        sprite_position(enemy1s[i].sprite,enemy1s[i].x,enemy1s[i].y);
-        enemy1s[i].isAlive = 1;
-        enemy1s[i].health = 10;
+        enemy_spawn(&enemies[n++], ENEMY_1, r1_xStart + (xOffset * i), -28);
     }
     int r2_xStart = 56;
     for (int i = 0; i < 5; i++) {
-        enemy2s[i].x = r2_xStart + (xOffset * i);
-        enemy2s[i].y = -16;
-        sprite_position(enemy2s[i].sprite,enemy2s[i].x,enemy2s[i].y);
-        enemy2s[i].isAlive = 1;
-        enemy2s[i].health = 20;
+        enemy_spawn(&enemies[n++], ENEMY_2, r2_xStart + (xOffset * i), -16);
     }
 }
 
-void spawn_formation5(struct Enemy enemy1s[], struct Enemy enemy2s[]) {
+void spawn_formation5(struct Enemy enemies[]) {
+    int n = 0;
     int xOffset = 20;
     int e1_xStart = 52;
     for (int i = 0; i < 7; i++) {
-        enemy1s[i].x = e1_xStart + (xOffset * i);
-        if (i % 2 == 0) {
-            enemy1s[i].y = -32;
-        } else {
-            enemy1s[i].y = -16;
-        }
-        sprite_position(enemy1s[i].sprite,enemy1s[i].x,enemy1s[i].y);
-        enemy1s[i].isAlive = 1;
-        enemy1s[i].health = 10;
+        enemy_spawn(&enemies[n++], ENEMY_1, e1_xStart + (xOffset * i),
+                (i % 2 == 0) ? -32 : -16);
     }
     int e2_xStart = 32;
     for (int i = 0; i < 9; i++) {
-        enemy2s[i].x = e2_xStart + (xOffset * i);
-        if (i % 2 == 0) {
-            enemy2s[i].y = -32;
-        } else {
-            enemy2s[i].y = -16;
-        }
-        sprite_position(enemy2s[i].sprite,enemy2s[i].x,enemy2s[i].y);
-        enemy2s[i].isAlive = 1;
-        enemy2s[i].health = 20;
+        enemy_spawn(&enemies[n++], ENEMY_2, e2_xStart + (xOffset * i),
+                (i % 2 == 0) ? -32 : -16);
     }
 }
 
-void spawn_formation6(struct Enemy enemy1s[], struct Enemy enemy2s[]) {
+void spawn_formation6(struct Enemy enemies[]) {
+    int n = 0;
     int xOffset = 24;
     int r1_xStart = 16;
     for (int i = 0; i < 9; i++) {
-        enemy2s[i].x = r1_xStart + (xOffset * i);
-        enemy2s[i].y = -36;
-        sprite_position(enemy2s[i].sprite,enemy2s[i].x,enemy2s[i].y);
-        enemy2s[i].isAlive = 1;
-        enemy2s[i].health = 20;
+        enemy_spawn(&enemies[n++], ENEMY_2, r1_xStart + (xOffset * i), -36);
     }
     int r2_xStart = 28;
     for (int i = 0; i < 8; i++) {
-        enemy1s[i].x = r2_xStart + (xOffset * i);
-        enemy1s[i].y = -26;
-        sprite_position(enemy1s[i].sprite,enemy1s[i].x,enemy1s[i].y);
-        enemy1s[i].isAlive = 1;
-        enemy1s[i].health = 10;
+        enemy_spawn(&enemies[n++], ENEMY_1, r2_xStart + (xOffset * i), -26);
     }
     int r3_xStart = 40;
-    for (int i = 9; i < 16; i++) {
-        enemy2s[i].x = r3_xStart + (xOffset * (i - 9));
-        enemy2s[i].y = -16;
-        sprite_position(enemy2s[i].sprite,enemy2s[i].x,enemy2s[i].y);
-        enemy2s[i].isAlive = 1;
-        enemy2s[i].health = 20;
+    for (int i = 0; i < 7; i++) {
+        enemy_spawn(&enemies[n++], ENEMY_2, r3_xStart + (xOffset * i), -16);
     }
 }
 
-void spawn_formation7(struct Enemy enemy1s[], struct Enemy enemy2s[], struct Enemy bosses[]) {
-    int enemy1Index = 0;
-    int enemy2Index = 0;
+void spawn_formation7(struct Enemy enemies[]) {
+    int n = 0;
     int xOffset = 18;
     int r1_xStart = 4;
     for (int i = 0; i < 13; i++) {
+        int type = ENEMY_2;
         if (i == 6) {
-            bosses[0].x = r1_xStart + (xOffset * i);
-            bosses[0].y = -44;
-            sprite_position(bosses[0].sprite,bosses[0].x,bosses[0].y);
-            bosses[0].isAlive = 1;
-            bosses[0].health = 50;
+            type = ENEMY_BOSS;
         } else if (i == 0 || i == 1 || i == 4 || i == 5 || i == 7 || i == 8 || i == 11 || i == 12) {
-            enemy1s[enemy1Index].x = r1_xStart + (xOffset * i);
-            enemy1s[enemy1Index].y = -44;
-            sprite_position(enemy1s[enemy1Index].sprite,enemy1s[enemy1Index].x,enemy1s[enemy1Index].y);
-            enemy1s[enemy1Index].isAlive = 1;
-            enemy1s[enemy1Index].health = 10;
-            enemy1Index++;
-        } else {
-            enemy2s[enemy2Index].x = r1_xStart + (xOffset * i);
-            enemy2s[enemy2Index].y = -44;
-            sprite_position(enemy2s[enemy2Index].sprite,enemy2s[enemy2Index].x,enemy2s[enemy2Index].y);
-            enemy2s[enemy2Index].isAlive = 1;
-            enemy2s[enemy2Index].health = 20; 
-            enemy2Index++;
+            type = ENEMY_1;
         }
+        enemy_spawn(&enemies[n++], type, r1_xStart + (xOffset * i), -44);
     }
     int r2_xStart = 40;
     for (int i = 0; i < 9; i++) {
-        if (i == 0 || i == 1 || i == 4 || i == 7 || i == 8) {
-            enemy1s[enemy1Index].x = r2_xStart + (xOffset * i);
-            enemy1s[enemy1Index].y = -30;
-            sprite_position(enemy1s[enemy1Index].sprite,enemy1s[enemy1Index].x,enemy1s[enemy1Index].y);
-            enemy1s[enemy1Index].isAlive = 1;
-            enemy1s[enemy1Index].health = 10;
-            enemy1Index++;
-        } else {
-            enemy2s[enemy2Index].x = r2_xStart + (xOffset * i);
-            enemy2s[enemy2Index].y = -30;
-            sprite_position(enemy2s[enemy2Index].sprite,enemy2s[enemy2Index].x,enemy2s[enemy2Index].y);
-            enemy2s[enemy2Index].isAlive = 1;
-            enemy2s[enemy2Index].health = 20; 
-            enemy2Index++;
-        }
+        int type = (i == 0 || i == 1 || i == 4 || i == 7 || i == 8) ? ENEMY_1 : ENEMY_2;
+        enemy_spawn(&enemies[n++], type, r2_xStart + (xOffset * i), -30);
     }
     int r3_xStart = 76;
     for (int i = 0; i < 5; i++) {
-        if (i != 2) {
-            enemy1s[enemy1Index].x = r3_xStart + (xOffset * i);
-            enemy1s[enemy1Index].y = -16;
-            sprite_position(enemy1s[enemy1Index].sprite,enemy1s[enemy1Index].x,enemy1s[enemy1Index].y);
-            enemy1s[enemy1Index].isAlive = 1;
-            enemy1s[enemy1Index].health = 10;
-            enemy1Index++;
-        } else {
-            enemy2s[enemy2Index].x = r3_xStart + (xOffset * i);
-            enemy2s[enemy2Index].y = -16;
-            sprite_position(enemy2s[enemy2Index].sprite,enemy2s[enemy2Index].x,enemy2s[enemy2Index].y);
-            enemy2s[enemy2Index].isAlive = 1;
-            enemy2s[enemy2Index].health = 20; 
-            enemy2Index++;
-        }
+        int type = i != 2 ? ENEMY_1 : ENEMY_2;
+        enemy_spawn(&enemies[n++], type, r3_xStart + (xOffset * i), -16);
     }
 }
 
-void spawn_EnemyFormation(int formationNum, struct Enemy enemy1s[], struct Enemy enemy2s[], struct Enemy bosses[]) {
+void spawn_EnemyFormation(int formationNum, struct Enemy enemies[]) {
     if (formationNum == 1) {
-        spawn_formation1(enemy1s);
+        spawn_formation1(enemies);
     } else if (formationNum == 2) {
-        spawn_formation2(enemy1s);
+        spawn_formation2(enemies);
     } else if (formationNum == 3) {
-        spawn_formation3(enemy1s);
+        spawn_formation3(enemies);
     } else if (formationNum == 4) {
-        spawn_formation4(enemy1s, enemy2s);
+        spawn_formation4(enemies);
     } else if (formationNum == 5) {
-        spawn_formation5(enemy1s, enemy2s);
+        spawn_formation5(enemies);
     } else if (formationNum == 6) {
-        spawn_formation6(enemy1s, enemy2s);
+        spawn_formation6(enemies);
     } else if (formationNum == 7) {
-        spawn_formation7(enemy1s, enemy2s, bosses);
+        spawn_formation7(enemies);
     }
 }
 
-/* finds which tile a screen coordinate maps to, 
- * taking scroll into account */
-unsigned short tile_lookup(int x, int y, int xscroll, int yscroll,
-        const unsigned short* tilemap, int tilemap_w, int tilemap_h) {
-
-    /* adjust for the scroll */
-    x += xscroll;
-    y += yscroll;
-
-    /* convert from screen coordinates to tile coordinates */
-    x >>= 3;
-    y >>= 3;
-
-    /* account for wraparound */
-    while (x >= tilemap_w) {
-        x -= tilemap_w;
-    }
-    while (y >= tilemap_h) {
-        y -= tilemap_h;
-    }
-    while (x < 0) {
-        x += tilemap_w;
-    }
-    while (y < 0) {
-        y += tilemap_h;
-    }
-
-    /* the larger screen maps (bigger than 32x32) are made of multiple 
-     * stitched
-       together - the offset is used for finding which screen block we 
-       are in
-       for these cases */
-    int offset = 0;
-
-    /* if the width is 64, add 0x400 offset to get to tile maps on right  */
-    if (tilemap_w == 64 && x >= 32) {
-        x -= 32;
-        offset += 0x400;
-    }
-
-    /* if height is 64 and were down there */
-    if (tilemap_h == 64 && y >= 32) {
-        y -= 32;
-
-        /* if width is also 64 add 0x800, else just 0x400 */
-        if (tilemap_w == 64) {
-            offset += 0x800;
-        } else {
-            offset += 0x400;
-        }
-    }
-
-    /* find the index in this tile map */
-    int index = y * 32 + x;
-
-    /* return the tile */
-    return tilemap[index + offset];
-}
-
 /* the control registers for the four tile layers */
 volatile unsigned short* bg0_control = (volatile unsigned short*) 0x4000008;
 volatile unsigned short* bg1_control = (volatile unsigned short*) 0x400000a;
@@ -779,12 +1661,51 @@ volatile short* bg3_y_scroll = (unsigned short*) 0x400001e;
  * much of the screen has been drawn */
 volatile unsigned short* scanline_counter = (volatile unsigned short*) 0x4000006;
 
-/* wait for the screen to be fully drawn so we can do something during vblank */
+void save_idle();
+
+/* wait for the start of the next vblank, giving the time spent waiting to
+ * background saving - a frame which ended inside vblank waits for the
+ * next one, so the game never runs twice in one */
 void wait_vblank() {
+    while (*scanline_counter >= 160) {
+        save_idle();
+    }
     /* wait until all 160 lines have been updated */
-    while (*scanline_counter < 160) { }
+    while (*scanline_counter < 160) {
+        save_idle();
+    }
+}
+
+
+/* BIOS VBlankIntrWait, halts the CPU until the next vblank interrupt */
+void vblankIntrWait();
+
+int save_busy();
+
+/* wait for the next vblank with the CPU halted, unless a save wants the
+ * time */
+void halt_vblank() {
+    if (save_busy()) {
+        wait_vblank();
+    } else {
+        vblankIntrWait();
+    }
 }
 
+/* the buttons down this frame and last frame, for catching presses */
+unsigned short buttons_down = 0;
+unsigned short buttons_last = 0;
+
+/* read the buttons once a frame */
+void buttons_poll() {
+    buttons_last = buttons_down;
+    buttons_down = ~*buttons & 0x3ff;
+}
+
+/* whether a button went down this frame */
+int button_tapped(unsigned short button) {
+    return (buttons_down & button) && !(buttons_last & button);
+}
 
 /* this function checks whether a particular button has been pressed */
 unsigned char button_pressed(unsigned short button) {
@@ -813,158 +1734,448 @@ volatile unsigned short* screen_block(unsigned long block) {
 }
 
 
-/* function to setup background 0 for this program */
-void setup_background() {
+/* the screen block background 0's map is streamed into */
+#define STAGE_BLOCK 16
+
+/* a stage background of any height, stored as run length encoded rows of
+ * 32 map entries in the order they scroll onto the screen, each run is a
+ * count followed by the map entry - the rows loop once they run out */
+struct StageMap {
+    const unsigned short* data;
+    int rows;
+};
+
+/* the stage backgrounds */
+const struct StageMap stages[] = {
+    { SpaceStage_data, SpaceStage_rows },
+};
+
+/* the stage being streamed, and the next compressed row to read */
+const struct StageMap* stream_stage;
+const unsigned short* stream_data;
+int stream_row;
+
+/* the world row the next decoded row goes in, going up the screen */
+int stream_world_row;
+
+/* decode the next row of the stage into dest */
+void stream_decode(unsigned short* dest) {
+    if (stream_row == stream_stage->rows) {
+        stream_data = stream_stage->data;
+        stream_row = 0;
+    }
+    int x = 0;
+    while (x < 32) {
+        int count = *stream_data++;
+        unsigned short entry = *stream_data++;
+        while (count--) {
+            dest[x++] = entry;
+        }
+    }
+    stream_row++;
+}
+
+/* go back to the start of a stage, the first row decoded is the bottom of
+ * the screen at scroll 0 and the rest go up from it - the loader fills the
+ * screen block with the first 32 */
+void stage_start(const struct StageMap* stage) {
+    stream_stage = stage;
+    stream_data = stage->data;
+    stream_row = 0;
+    stream_world_row = (HEIGHT / 8);
+}
+
+/* the palette entries for the stars, past the space background's colors */
+#define STAR_COLOR_NEAR 254
+#define STAR_COLOR_FAR 255
+
+/* the number of star tiles, after the empty tile 0 */
+#define STAR_TILES 4
+
+/* fill some rows of a star layer's screen block with a scattering of star
+ * tiles, carrying on from the seed the rows before left */
+void starfield_map(int block, int tile_base, unsigned int* seed, int first, int count) {
+    volatile unsigned short* dest = screen_block(block) + first * 32;
+    unsigned int s = *seed;
+    for (int i = 0; i < count * 32; i++) {
+        /* a small LCG, about one cell in sixteen gets a star */
+        s = s * 1103515245 + 12345;
+        int r = (s >> 16) & 0xff;
+        dest[i] = (r < 16) ? tile_base + (r & (STAR_TILES - 1)) : 0;
+    }
+    *seed = s;
+}
+
+/* where each star layer's scattering has got to */
+unsigned int star_seeds[2];
 
-    /* load the palette from the image into palette memory*/
-    for (int i = 0; i < PALETTE_SIZE; i++) {
-        bg_palette[i] = SpaceBackgroundImage_palette[i];
+/* fill some rows of both star layers, from the top */
+void starfield_rows(int first, int count) {
+    if (first == 0) {
+        star_seeds[0] = 7;
+        star_seeds[1] = 31;
     }
+    starfield_map(15, 1, &star_seeds[0], first, count);
+    starfield_map(14, 1 + STAR_TILES, &star_seeds[1], first, count);
+}
 
-    /* load the image into char block 0 (16 bits at a time) */
-    volatile unsigned short* dest = char_block(0);
-    unsigned short* image = (unsigned short*) SpaceBackgroundImage_data;
-    for (int i = 0; i < ((SpaceBackgroundImage_width * SpaceBackgroundImage_height) / 2); i++) {
-        dest[i] = image[i];
+/* build the star tiles for background 1 and 2 */
+void setup_starfield() {
+    bg_palette[STAR_COLOR_NEAR] = 0x7fff;
+    bg_palette[STAR_COLOR_FAR] = 0x294a;
+
+    /* clear tile 0 and the star tiles for both colors in char block 1 */
+    volatile unsigned short* tiles = char_block(1);
+    memset32((void*) tiles, 0, (1 + 2 * STAR_TILES) * 64);
+
+    /* each star tile has one pixel lit in a different spot, near stars are
+     * tiles 1-4 and far stars 5-8 (a tile is 32 halfwords at 256 colors) */
+    for (int i = 0; i < STAR_TILES; i++) {
+        int pixel = (i * 19 + 9) & 63;
+        int shift = (pixel & 1) ? 8 : 0;
+        tiles[(1 + i) * 32 + pixel / 2] = STAR_COLOR_NEAR << shift;
+        tiles[(1 + STAR_TILES + i) * 32 + pixel / 2] = STAR_COLOR_FAR << shift;
     }
+}
 
+/* the background palette entries the stage may use, banks 14 and 15 are
+ * the HUD font and the stars */
+#define STAGE_COLORS 224
+
+/* function to setup background 0 for this program, once the loader has
+ * put its palette and tiles in */
+void setup_background() {
     /* set all control the bits in this register */
-    *bg0_control = 1 |    /* priority, 0 is highest, 3 is lowest */
+    *bg0_control = 2 |    /* priority, 0 is highest, 3 is lowest */
         (0 << 2)  |       /* the char block the image data is stored in */
         (0 << 6)  |       /* the mosaic flag */
         (1 << 7)  |       /* color mode, 0 is 16 colors, 1 is 256 colors */
         (16 << 8) |       /* the screen block the tile data is stored in */
         (1 << 13) |       /* wrapping flag */
         (0 << 14);        /* bg size, 0 is 256x256 */
-     
+}
+
+/* turn on backgrounds 1 and 2, once the loader has built the star tiles
+ * and filled in their maps */
+void setup_stars() {
+    /* the near stars, in front of the space background */
     *bg1_control = 0 |
-        (0 << 2)  |       /* the char block the image data is stored in */
+        (1 << 2)  |       /* the char block the image data is stored in */
         (0 << 6)  |       /* the mosaic flag */
         (1 << 7)  |       /* color mode, 0 is 16 colors, 1 is 256 colors */
         (15 << 8) |       /* the screen block the tile data is stored in */
         (1 << 13) |       /* wrapping flag */
         (0 << 14);
 
+    /* the far stars, between the near stars and the space background */
+    *bg2_control = 1 |
+        (1 << 2)  |       /* the char block the image data is stored in */
+        (0 << 6)  |       /* the mosaic flag */
+        (1 << 7)  |       /* color mode, 0 is 16 colors, 1 is 256 colors */
+        (14 << 8) |       /* the screen block the tile data is stored in */
+        (1 << 13) |       /* wrapping flag */
+        (0 << 14);
+}
+
+
+/* timers 2 and 3, cascaded into one 32 bit cycle counter for profiling */
+volatile unsigned short* timer2_data = (volatile unsigned short*) 0x4000108;
+volatile unsigned short* timer2_control = (volatile unsigned short*) 0x400010A;
+volatile unsigned short* timer3_data = (volatile unsigned short*) 0x400010C;
+volatile unsigned short* timer3_control = (volatile unsigned short*) 0x400010E;
+
+/* timer control flags */
+#define TIMER_ENABLE 0x80
+#define TIMER_CASCADE 0x04
+
+/* start counting CPU cycles */
+void profile_start() {
+    *timer2_control = 0;
+    *timer3_control = 0;
+    *timer2_data = 0;
+    *timer3_data = 0;
+    *timer3_control = TIMER_ENABLE | TIMER_CASCADE;
+    *timer2_control = TIMER_ENABLE;
+}
+
+/* stop counting and return the cycles since profile_start */
+unsigned int profile_stop() {
+    *timer2_control = 0;
+    return *timer2_data | (*timer3_data << 16);
+}
+
+/* a background which scrolls by a constant rate each frame */
+struct ScrollLayer {
+    /* the scroll position and the per frame rate, in 8.8 fixed point */
+    int x, y;
+    int dx, dy;
+
+    /* the scroll registers for this background */
+    volatile short* x_scroll;
+    volatile short* y_scroll;
+};
+
+/* the space background and the two star layers, nearer layers move faster */
+struct ScrollLayer scroll_layers[3] = {
+    { 0, 0, 0, -0x55, (volatile short*) 0x4000010, (volatile short*) 0x4000012 },
+    { 0, 0, 0, -0x100, (volatile short*) 0x4000014, (volatile short*) 0x4000016 },
+    { 0, 0, 0, -0x80, (volatile short*) 0x4000018, (volatile short*) 0x400001a },
+};
+
+/* advance all the layers by a frame, the registers are only written
+ * by the vblank handler */
+void scroll_update() {
+    for (int i = 0; i < 3; i++) {
+        scroll_layers[i].x += scroll_layers[i].dx;
+        scroll_layers[i].y += scroll_layers[i].dy;
+    }
+}
+
+/* copy the layer positions into the scroll registers */
+void scroll_write() {
+    for (int i = 0; i < 3; i++) {
+        *scroll_layers[i].x_scroll = scroll_layers[i].x >> 8;
+        *scroll_layers[i].y_scroll = scroll_layers[i].y >> 8;
+    }
+}
 
+/* a decoded row waiting for vblank, and the map entry it starts at */
+unsigned short stream_buffer[32] __attribute__((aligned(4)));
+int stream_slot;
+volatile int stream_pending = 0;
+
+/* decode the next row once the one above the top of the screen is needed,
+ * it gets queued for the screen block and stays pending until copied - if
+ * the queue is full the decode is undone and tried again next frame */
+void stream_update() {
+    if (stream_pending) {
+        return;
+    }
 
-    /* load the tile data into screen block 16 */
-    dest = screen_block(16);
-    for (int i = 0; i < (SpaceBackgroundMap_width * SpaceBackgroundMap_height); i++) {
-        dest[i] = SpaceBackgroundMap[i];
+    /* the world row just above the top of the screen */
+    int top = (scroll_layers[0].y >> 8) >> 3;
+    if (stream_world_row >= top - 1) {
+        const unsigned short* data = stream_data;
+        int row = stream_row;
+        stream_decode(stream_buffer);
+        stream_slot = tile_index_pow2(0, stream_world_row, 32, 32);
+        stream_pending = 1;
+        if (!dma_queue_add((void*) (screen_block(STAGE_BLOCK) + stream_slot),
+                    stream_buffer, sizeof(stream_buffer), DMA_PRIORITY_MAP,
+                    &stream_pending)) {
+            stream_pending = 0;
+            stream_data = data;
+            stream_row = row;
+            return;
+        }
+        stream_world_row--;
     }
 }
 
+/* two tables of background 0 scroll values, x in the low half and y in the
+ * high half of each word, so one 32 bit DMA sets both registers - entry
+ * 0 is written in vblank and the rest by DMA at the end of each line, the
+ * last one lands after line 159 and is overwritten by the next vblank */
+unsigned int scanline_tables[2][SCANLINES + 1];
 
-/* just kill time */
-void delay(unsigned int amount) {
-    for (int i = 0; i < amount * 10; i++);
+/* the table the DMA is playing, and whether the other one is built */
+volatile int scanline_front = 0;
+volatile int scanline_ready = 0;
+
+/* whether the vblank handler should run the DMA at all */
+volatile int scanline_running = 0;
+
+/* the effect playing, its length and frames left */
+int scanline_effect = SCANLINE_NONE;
+int scanline_length = 0;
+int scanline_frames = 0;
+
+/* cycles the last table took to build */
+unsigned int scanline_cycles = 0;
+
+/* both background 0 scroll registers as one word */
+volatile unsigned int* bg0_scroll = (volatile unsigned int*) 0x4000010;
+
+/* play a scanline effect for a number of frames */
+void scanline_start(int effect, int frames) {
+    scanline_effect = effect;
+    scanline_length = frames;
+    scanline_frames = frames;
+}
+
+/* build next frame's table while the current one plays */
+void scanline_update() {
+    if (scanline_effect == SCANLINE_NONE || scanline_ready) {
+        return;
+    }
+    if (scanline_frames == 0) {
+        scanline_effect = SCANLINE_NONE;
+        scanline_running = 0;
+        return;
+    }
+
+    unsigned int* back = scanline_tables[scanline_front ^ 1];
+    int x = scroll_layers[0].x >> 8;
+    int y = scroll_layers[0].y >> 8;
+    int left = scanline_frames--;
+
+    /* the map ring holds the 32 rows below the next one to stream */
+    int bottom = (stream_world_row + 1 + 32) * 8;
+
+    profile_start();
+    scanline_build(back, scanline_effect, x, y, bottom, left, scanline_length);
+    scanline_cycles = profile_stop();
+
+    scanline_ready = 1;
+    scanline_running = 1;
 }
 
-void scrollBG1(int* xscroll, int* yscroll){
-    *bg1_x_scroll = *xscroll * 2;
-    *bg1_y_scroll = *yscroll * 2;
+/* swap in the newest table and restart the DMA for this frame */
+void scanline_vblank() {
+    /* stop last frame's transfer */
+    *dma0_count = 0;
+    if (!scanline_running) {
+        return;
+    }
+
+    if (scanline_ready) {
+        scanline_front ^= 1;
+        scanline_ready = 0;
+    }
+
+    unsigned int* table = scanline_tables[scanline_front];
+    *bg0_scroll = table[0];
+    *dma0_source = (unsigned int) &table[1];
+    *dma0_destination = (unsigned int) bg0_scroll;
+    *dma0_count = 1 | DMA_32 | DMA_DEST_RELOAD | DMA_REPEAT | DMA_AT_HBLANK | DMA_ENABLE;
 }
 
-/* automatically scroll background 0 */
-void scrollBG0(int* xscroll, int* yscroll, int* count){
-    *count+=1;
-    if ((*count) == 3){
-        *xscroll+= 0;
-        *yscroll-= 1;
-        *bg0_x_scroll = *xscroll;
-        *bg0_y_scroll = *yscroll;
-        *count=0;
+/* the interrupt handler, runs at the start of every vblank and before each
+ * multiplexer band */
+void on_vblank() {
+    /* disable interrupts for now and save current state of interrupt */
+    *interrupt_enable = 0;
+    unsigned short temp = *interrupt_state;
+
+    if ((temp & INTERRUPT_VBLANK) == INTERRUPT_VBLANK) {
+        scroll_write();
+        scanline_vblank();
+        dma_queue_vblank();
+        mux_vblank();
+    }
+    if ((temp & INTERRUPT_VCOUNT) == INTERRUPT_VCOUNT) {
+        mux_vcount();
     }
+
+    /* restore/enable interrupts, telling the BIOS too */
+    *bios_interrupt_flags |= temp;
+    *interrupt_state = temp;
+    *interrupt_enable = 1;
+}
+
+/* install on_vblank and turn on the vblank and vcount interrupts, the
+ * vcount line is set each frame by the multiplexer */
+void setup_interrupts() {
+    *interrupt_enable = 0;
+    *interrupt_callback = (unsigned int) &on_vblank;
+    *interrupt_selection |= INTERRUPT_VBLANK | INTERRUPT_VCOUNT;
+    *display_interrupts |= 0x08;
+    *interrupt_enable = 1;
 }
 
 /* kill an enemy if its health has reached zero */
 void enemy_checkDeath(struct Enemy* enemy) {
     if (enemy->health <= 0 && !enemy->isExploding) {
         enemy->isExploding = 1;
-        enemy->explosionTimer = 30;         
+        anim_play(enemy->sprite, enemy_types[enemy->type].death);
+        particle_debris(enemy->x, enemy->y);
         enemy->isAlive = 0;
-        int offset=enemy->sprite->attribute2|0;
-        SSCORE=increaseScore(SSCORE,offset);
+        SSCORE=increaseScore(SSCORE,&enemy_types[enemy->type]);
     }
 }
+/* start the player's death animation */
+void player_explode(struct Player* player){
+    if(player->isAlive && !player->isExploding){
+        player->isExploding = 1;
+        anim_play(player->sprite, &player_death);
+    }
+}
+
+/* the player is dead once its death animation has run out */
 void player_explosion_update(struct Player* player){
-    if(player->isExploding){
-        if(player->explosionTimer > 40){
-            sprite_set_offset(player->sprite, PEx1);
-        }else if(player->explosionTimer > 30){
-            sprite_set_offset(player->sprite, PEx2);
-        }else if(player->explosionTimer > 20){
-            sprite_set_offset(player->sprite, Explosion2);
-        }else if(player->explosionTimer > 10){
-            sprite_set_offset(player->sprite, Explosion1);
-        }else{
-            player->isAlive = 0; 
+    if(player->isExploding && !anim_playing(player->sprite)){
+        player->isExploding = 0;
+        player->isAlive = 0; 
+        if (player_lives > 0) {
+            player_lives--;
         }
-        player->explosionTimer--; 
     }
 }
 
-
+/* put an enemy back in reserve once its explosion has run out */
 void explosion_update(struct Enemy* enemy){
-    if(enemy->isExploding){
-        if(enemy->explosionTimer > 15){
-            sprite_set_offset(enemy->sprite, Explosion1);
-        }else if(enemy->explosionTimer > 0){
-            sprite_set_offset(enemy->sprite, Explosion2);
-        }else{
-            enemy->isExploding = 0;
-            enemy->isAlive = 0;
-            sprite_set_offset(enemy->sprite, enemy->ogOffset); 
-            sprite_position(enemy->sprite,WIDTH,HEIGHT); 
-        }
-        enemy->explosionTimer--; 
-    }
-}
-
-/* check if a bullet has collided with an enemy */
-void bulletEnemy_Collision(struct Bullet* pBullet, struct Enemy enemy1s[], struct Enemy enemy2s[], struct Enemy bosses[]) {
-    for (int j = 0; j < 20; j++) {
-        if (enemy1s[j].isAlive) {
-            if ((pBullet->x + 8 >= enemy1s[j].x && pBullet->x <= enemy1s[j].x + 12) && pBullet->y <= enemy1s[j].y + 12) {
-                enemy1s[j].health -= 10;
-                enemy_checkDeath(&enemy1s[j]);
-                pBullet->active = 0;
-                pBullet->yvel = 0;
-                pBullet->x = -16;
-                pBullet->y = -16;
-                sprite_position(pBullet->sprite, pBullet->x, pBullet->y);
-            }
-        }
+    if(enemy->isExploding && !anim_playing(enemy->sprite)){
+        enemy->isExploding = 0;
+        enemy->isAlive = 0;
+        anim_play(enemy->sprite, enemy_types[enemy->type].idle); 
+        sprite_position(enemy->sprite,WIDTH,HEIGHT); 
     }
-    for (int j = 0; j < 20; j++) {
-        if (enemy2s[j].isAlive) {
-            if (pBullet->x + 4 >= enemy2s[j].x && pBullet->x <= enemy2s[j].x + 12 && pBullet->y <= enemy2s[j].y + 12) {
-                enemy2s[j].health -= 10;
-                enemy_checkDeath(&enemy2s[j]);
-                pBullet->active = 0;
-                pBullet->yvel = 0;
-                pBullet->x = -16;
-                pBullet->y = -16;
-                sprite_position(pBullet->sprite, pBullet->x, pBullet->y);    
+}
+
+/* check if a bullet overlaps an enemy's hitbox, which runs from the top
+ * of its sprite down - bullets and enemies close by at most two lines a
+ * frame, so a bullet can't get past the bottom without hitting */
+int bullet_hitsEnemy(struct Bullet* pBullet, struct Enemy* enemy) {
+    const struct EnemyType* t = &enemy_types[enemy->type];
+    return pBullet->x + t->hit_left >= enemy->x &&
+        pBullet->x <= enemy->x + t->hit_right &&
+        pBullet->y >= enemy->y &&
+        pBullet->y <= enemy->y + t->hit_bottom;
+}
+
+/* the screen cut into 8x8 cells laid out like a 32x32 map, each with a bit
+ * for every enemy whose hitbox reaches into it, so a bullet looks up its
+ * cell and only tests the enemies there - off screen hitboxes wrap round
+ * onto cells no bullet gets to */
+unsigned int enemy_cells[32 * 32] __attribute__((aligned(4)));
+_Static_assert(NUM_ENEMIES <= 32, "an enemy's cell bit doesn't fit");
+
+/* mark the cells of every live enemy's hitbox, once they have moved */
+void enemy_cells_build(struct Enemy enemies[]) {
+    memset32(enemy_cells, 0, sizeof(enemy_cells));
+    for (int i = 0; i < NUM_ENEMIES; i++) {
+        struct Enemy* enemy = &enemies[i];
+        if (!enemy->isAlive) {
+            continue;
+        }
+        const struct EnemyType* t = &enemy_types[enemy->type];
+        for (int y = enemy->y >> 3; y <= (enemy->y + t->hit_bottom) >> 3; y++) {
+            for (int x = (enemy->x - t->hit_left) >> 3; x <= (enemy->x + t->hit_right) >> 3; x++) {
+                enemy_cells[tile_index_pow2(x, y, 32, 32)] |= 1 << i;
             }
         }
     }
-    for (int j = 0; j < 3; j++) {
-        if (bosses[j].isAlive) {
-            if (pBullet->x + 4 >= bosses[j].x && pBullet->x <= bosses[j].x + 12 && pBullet->y <= bosses[j].y + 12) {
-                bosses[j].health -= 10;
-                enemy_checkDeath(&bosses[j]);
-                pBullet->active = 0;
-                pBullet->yvel = 0;
-                pBullet->x = -16;
-                pBullet->y = -16;
-                sprite_position(pBullet->sprite, pBullet->x, pBullet->y); 
-            }
+}
+
+/* check if a bullet has collided with an enemy in its cell, the hitbox is
+ * the enemy's archetype's */
+void bulletEnemy_Collision(struct Bullet* pBullet, struct Enemy enemies[]) {
+    unsigned int near = enemy_cells[tile_index_pow2(pBullet->x >> 3, pBullet->y >> 3, 32, 32)];
+    for (int j = 0; near; j++, near >>= 1) {
+        if ((near & 1) && enemies[j].isAlive && bullet_hitsEnemy(pBullet, &enemies[j])) {
+            particle_sparks(pBullet->x, pBullet->y);
+            enemies[j].health -= 10;
+            enemy_checkDeath(&enemies[j]);
+            pBullet->active = 0;
+            pBullet->yvel = 0;
+            pBullet->x = -16;
+            pBullet->y = -16;
+            sprite_position(pBullet->sprite, pBullet->x, pBullet->y);
         }
     }
 }
 
-void update_bullet(struct Bullet* pbullet, struct Enemy enemy1s[], struct Enemy enemy2s[], struct Enemy bosses[]) {
+void update_bullet(struct Bullet* pbullet, struct Enemy enemies[]) {
    // if the bullet has been fired and hits top of the screen, reset the bullet
     if(pbullet->active == 1 && pbullet->y <=0){
         pbullet->active = 0;
@@ -976,7 +2187,7 @@ void update_bullet(struct Bullet* pbullet, struct Enemy enemy1s[], struct Enemy
     }else if(pbullet->active == 1 && pbullet->y > 0){
         pbullet->y -= 1;
         sprite_move(pbullet->sprite, 0, pbullet->yvel);
-        bulletEnemy_Collision(pbullet, enemy1s, enemy2s, bosses);
+        bulletEnemy_Collision(pbullet, enemies);
     }else if(pbullet->active == 0){
         pbullet->yvel = 0;
         pbullet->x = -16;
@@ -985,15 +2196,16 @@ void update_bullet(struct Bullet* pbullet, struct Enemy enemy1s[], struct Enemy
     }
 }
 
-void update_bullets(struct Bullet pBullets[], struct Enemy enemy1s[], struct Enemy enemy2s[], struct Enemy bosses[]){
+void update_bullets(struct Bullet pBullets[], struct Enemy enemies[]){
      for(int i = 0; i < 20; i++){
-        update_bullet(&pBullets[i], enemy1s, enemy2s, bosses);
+        update_bullet(&pBullets[i], enemies);
      } 
 }
 
 
 /* update the player sprite */
 void player_update(struct Player* player) {
+    player_explosion_update(player);
     if(player->isAlive == 1){
     sprite_position(player->sprite, player->x, player->y);
     }else{
@@ -1004,9 +2216,56 @@ void player_update(struct Player* player) {
 /* check if an enemy has hit the bottom of the screen */
 void enemy_screenCollision(struct Enemy* enemy, struct Player* player) {
     if (enemy->y >= HEIGHT - 12) {
-        player->isExploding = 1;
-        player_explosion_update(player);
-        // you lose
+        player_explode(player);
+    }
+}
+
+/* the descending behavior, move straight down one pixel */
+void enemy_descend(struct Enemy* enemy, struct Player* player) {
+    enemy->y += 1;
+    sprite_move(enemy->sprite, 0, 1);
+    enemy_screenCollision(enemy, player);
+}
+
+/* a diver's speed down the screen, the same as a descender's pixel every
+ * 15 frames, and how hard and how far it swings across, in 1/256 pixels
+ * a frame */
+#define DIVE_DROP 17
+#define DIVE_TURN 1
+#define DIVE_SWING 32
+
+/* the diving behavior, run every frame - swing across towards the player
+ * on the way down, overshooting into a curve either side of it, with the
+ * sprite turned to the way it is going */
+void enemy_dive(struct Enemy* enemy, struct Player* player) {
+    if (player->x > enemy->x && enemy->xvel < DIVE_SWING) {
+        enemy->xvel += DIVE_TURN;
+    } else if (player->x < enemy->x && enemy->xvel > -DIVE_SWING) {
+        enemy->xvel -= DIVE_TURN;
+    }
+    enemy->yvel = DIVE_DROP;
+
+    /* stay on the screen, coming straight down against an edge */
+    enemy->fx += enemy->xvel;
+    if (enemy->fx < 0 || enemy->fx > (WIDTH - 16) << 8) {
+        enemy->fx -= enemy->xvel;
+        enemy->xvel = 0;
+    }
+    enemy->fy += enemy->yvel;
+
+    int x = enemy->fx >> 8;
+    int y = enemy->fy >> 8;
+    if (x != enemy->x || y != enemy->y) {
+        sprite_move(enemy->sprite, x - enemy->x, y - enemy->y);
+        enemy->x = x;
+        enemy->y = y;
+        enemy_screenCollision(enemy, player);
+    }
+
+    int heading = heading_toward(enemy->xvel, enemy->yvel);
+    if (heading != enemy->heading) {
+        enemy->heading = heading;
+        sprite_rotate(enemy->sprite, heading);
     }
 }
 
@@ -1018,213 +2277,1393 @@ void enemy_update(struct Enemy* enemy, struct Player* player) {
     if (enemy->isAlive) {
         enemy->counter++;
         if (enemy->counter >= enemy->animation_delay) {
-            enemy->y += 1;
-            sprite_move(enemy->sprite, 0, 1);
-            enemy_screenCollision(enemy, player);
+            enemy_types[enemy->type].behavior(enemy, player);
             enemy->counter = 0;
         }
     }
 }
 
-/* check if the current formation has been beaten (1=yes, 0=no) */
-int formation_check(int formationNum, struct Enemy enemy1s[], struct Enemy enemy2s[], struct Enemy bosses[]) {
-    int enemy1Size = 0;
-    int enemy2Size = 0;
-    int bossSize = 0;
-    if (formationNum == 1) {
-        enemy1Size = 3;
-    } else if (formationNum == 2) {
-        enemy1Size = 6;
-    } else if (formationNum == 3) {
-        enemy1Size = 9;
-    } else if (formationNum == 4) {
-        enemy1Size = 8;
-        enemy2Size = 5;
-    } else if (formationNum == 5) {
-        enemy1Size = 7;
-        enemy2Size = 9;
-    } else if (formationNum == 6) {
-        enemy1Size = 8;
-        enemy2Size = 16;
-    } else if (formationNum == 7) {
-        enemy1Size = 17;
-        enemy2Size = 9;
-        bossSize = 1;
-    }
-    for (int i = 0; i < enemy1Size; i++) {
-        if (enemy1s[i].isAlive == 1 || enemy1s[i].isExploding == 1) {
+/* check if the current formation has been beaten (1=yes, 0=no), the
+ * enemies it didn't spawn are never alive */
+int formation_check(struct Enemy enemies[]) {
+    for (int i = 0; i < NUM_ENEMIES; i++) {
+        if (enemies[i].isAlive == 1 || enemies[i].isExploding == 1) {
             return 0;
         }
     }
-    for (int i = 0; i < enemy2Size; i++) {
-        if (enemy2s[i].isAlive == 1 || enemy2s[i].isExploding == 1) {
-            return 0;
+    return 1;
+}
+
+/* update an enemy formation, each enemy does what its archetype does */
+void formation_update(struct Enemy enemies[], struct Player* player) {
+    for (int i = 0; i < NUM_ENEMIES; i++) {
+        enemy_update(&enemies[i], player);
+    }
+}
+
+/* the save memory, SRAM or flash on an 8 bit bus so only byte reads and
+ * writes work - build with SAVE_FLASH defined for a flash cart, the
+ * string tells emulators and flash carts which one to give us */
+volatile unsigned char* save_memory = (volatile unsigned char*) 0xE000000;
+#ifdef SAVE_FLASH
+const char save_type[] __attribute__((used, aligned(4))) = "FLASH_V126";
+#else
+const char save_type[] __attribute__((used, aligned(4))) = "SRAM_V113";
+#endif
+
+/* the most bytes written to SRAM in one frame, which bounds the time a
+ * save takes out of the frame */
+#define SAVE_BYTES_PER_FRAME 32
+
+/* the high scores, and how far SRAM has been brought up to date with
+ * them, -1 once it matches */
+struct ScoreTable scores;
+int save_cursor = -1;
+
+/* the SRAM copy the next save goes over, and the generation of the other */
+int save_copy = 0;
+unsigned char save_generation = 0;
+
+/* the cost of saving */
+struct SaveStats {
+    /* bytes actually changed in SRAM, the rest matched already */
+    int bytes;
+
+    /* the frames the last save was spread over */
+    int frames;
+
+    /* the cycles of the last frame that saved (or flash step), and the
+     * most ever */
+    unsigned int cycles;
+    unsigned int worst;
+};
+struct SaveStats save_stats;
+
+#ifdef SAVE_FLASH
+/* the flash journal, written a step at a time while waiting for vblank */
+struct Journal journal;
+
+/* the flash commands go to two magic addresses */
+void flash_command(unsigned char command) {
+    save_memory[0x5555] = 0xaa;
+    save_memory[0x2aaa] = 0x55;
+    save_memory[0x5555] = command;
+}
+
+unsigned char flash_read(int address) {
+    return save_memory[address];
+}
+
+void flash_erase(int sector) {
+    flash_command(0x80);
+    save_memory[0x5555] = 0xaa;
+    save_memory[0x2aaa] = 0x55;
+    save_memory[sector * FLASH_SECTOR] = 0x30;
+}
+
+void flash_program(int address, unsigned char value) {
+    flash_command(0xa0);
+    save_memory[address] = value;
+}
+#else
+unsigned char sram_read(int address) {
+    return save_memory[address];
+}
+#endif
+
+/* read the table from the save memory, falling back to the defaults (and
+ * writing them out) if it is blank or bad */
+void save_load() {
+#ifdef SAVE_FLASH
+    if (!journal_recover(&journal, &scores)) {
+        save_defaults(&scores);
+        journal.pending = 1;
+    }
+#else
+    int newest = sram_recover(&scores, &save_generation);
+    if (newest < 0) {
+        save_defaults(&scores);
+        save_cursor = 0;
+    } else {
+        save_copy = newest ^ 1;
+    }
+#endif
+    high_score = scores.entries[0].score;
+}
+
+/* copy the next few changed bytes of the table over the older SRAM copy,
+ * the entries go first, then the header, then the generation byte which
+ * makes it the newer - a save cut off part way fails its CRC or keeps its
+ * old generation, so the other copy is loaded rather than half a table -
+ * flash is written in save_idle and only counted here */
+void save_update() {
+#ifdef SAVE_FLASH
+    if (journal.pending || journal.state != JOURNAL_IDLE) {
+        save_stats.frames++;
+    }
+#else
+    if (save_cursor < 0) {
+        return;
+    }
+    profile_start();
+    const unsigned char* table = (const unsigned char*) &scores;
+    int header = sizeof(struct SaveHeader);
+    int base = save_copy * SRAM_COPY_BYTES;
+    int written = 0;
+    while (save_cursor < (int) sizeof(scores) && written < SAVE_BYTES_PER_FRAME) {
+        int i = (save_cursor + header) % (int) sizeof(scores);
+        if (save_memory[base + i] != table[i]) {
+            save_memory[base + i] = table[i];
+            written++;
         }
+        save_cursor++;
     }
-    for (int i = 0; i < bossSize; i++) {
-        if (bosses[i].isAlive == 1 || bosses[i].isExploding == 1) {
-            return 0;
+    if (save_cursor == (int) sizeof(scores) && written < SAVE_BYTES_PER_FRAME) {
+        save_memory[sram_generation(save_copy)] = ++save_generation;
+        save_copy ^= 1;
+        save_cursor = -1;
+        written++;
+    }
+    save_stats.bytes += written;
+    save_stats.frames++;
+
+    save_stats.cycles = profile_stop();
+    if (save_stats.cycles > save_stats.worst) {
+        save_stats.worst = save_stats.cycles;
+    }
+#endif
+}
+
+/* called over and over while waiting for vblank, each call does one short
+ * step of a flash save and never waits on the chip, so erasing and
+ * programming happen in time the frame had spare */
+void save_idle() {
+#ifdef SAVE_FLASH
+    if (!save_busy()) {
+        return;
+    }
+    profile_start();
+    journal_step(&journal, &scores);
+    save_stats.cycles = profile_stop();
+    if (save_stats.cycles > save_stats.worst) {
+        save_stats.worst = save_stats.cycles;
+    }
+#endif
+}
+
+/* whether a flash save is still under way */
+int save_busy() {
+#ifdef SAVE_FLASH
+    return journal.pending || journal.state != JOURNAL_IDLE || journal.wait_address >= 0;
+#else
+    return 0;
+#endif
+}
+
+/* start writing the table out */
+void save_start() {
+#ifdef SAVE_FLASH
+    journal.pending = 1;
+#else
+    save_cursor = 0;
+#endif
+    save_stats.bytes = 0;
+    save_stats.frames = 0;
+}
+
+/* put the score of the game that just ended in the table, and start
+ * saving it if it made it in */
+void score_submit(int stage) {
+    if (save_insert(&scores, SSCORE, "YOU", stage) >= 0) {
+        save_start();
+    }
+}
+
+/* the HUD and messages are text on background 3, in front of everything -
+ * the font goes in char block 3 with glyph c at tile c - Font_first, so a
+ * space is the blank tile 0, and the map in screen block 17 */
+#define TEXT_BLOCK 17
+#define TEXT_CHAR_BLOCK 3
+#define TEXT_PALETTE 14
+
+/* the visible text grid */
+#define TEXT_COLS 30
+#define TEXT_ROWS 20
+
+/* a copy of the visible rows of the text map, with the span of each row
+ * changed since it was last queued - static text costs nothing */
+unsigned short text_map[TEXT_ROWS][32] __attribute__((aligned(4)));
+int text_dirty = 0;
+unsigned char text_lo[TEXT_ROWS];
+unsigned char text_hi[TEXT_ROWS];
+
+/* set while a row is queued, so it is not queued twice */
+volatile int text_pending[TEXT_ROWS];
+
+/* the text rows queued in the last flush */
+int text_rows_flushed = 0;
+
+/* the map entry of a character */
+static inline unsigned short text_entry(int c) {
+    return (c - Font_first) | (TEXT_PALETTE << 12);
+}
+
+/* change one cell, marking it dirty only if it is different */
+void text_put(int col, int row, unsigned short entry) {
+    if (col < 0 || col >= TEXT_COLS || row < 0 || row >= TEXT_ROWS ||
+            text_map[row][col] == entry) {
+        return;
+    }
+    text_map[row][col] = entry;
+    if (!(text_dirty & (1 << row))) {
+        text_dirty |= 1 << row;
+        text_lo[row] = col;
+        text_hi[row] = col + 1;
+    } else if (col < text_lo[row]) {
+        text_lo[row] = col;
+    } else if (col >= text_hi[row]) {
+        text_hi[row] = col + 1;
+    }
+}
+
+/* write a string, returns the column after it */
+int text_print(int col, int row, const char* text) {
+    while (*text) {
+        text_put(col++, row, text_entry(*text++));
+    }
+    return col;
+}
+
+/* blank some cells */
+void text_clear(int col, int row, int count) {
+    while (count-- > 0) {
+        text_put(col++, row, 0);
+    }
+}
+
+/* write a number with at least width digits, zeros are added on the left,
+ * returns the number of digits written */
+int text_number(int col, int row, int value, int width) {
+    char digits[12];
+    int length = 0;
+    unsigned int v = value < 0 ? 0 : value;
+    do {
+        digits[length++] = v % 10;
+        v /= 10;
+    } while (v);
+    while (length < width) {
+        digits[length++] = 0;
+    }
+
+    /* the digits follow each other in the font */
+    unsigned short zero = text_entry('0');
+    for (int i = 0; i < length; i++) {
+        text_put(col + i, row, zero + digits[length - 1 - i]);
+    }
+    return length;
+}
+
+/* write a string in the middle of a row, blanking the rest of it */
+void text_center(int row, const char* text) {
+    int length = 0;
+    while (text[length]) {
+        length++;
+    }
+    int col = (TEXT_COLS - length) / 2;
+    text_clear(0, row, col);
+    col = text_print(col, row, text);
+    text_clear(col, row, TEXT_COLS - col);
+}
+
+/* queue the changed part of each dirty row for vblank, rounded out to
+ * whole words - a row still waiting from last time stays dirty */
+void text_flush() {
+    text_rows_flushed = 0;
+    for (int row = 0; text_dirty >> row; row++) {
+        if (!(text_dirty & (1 << row)) || text_pending[row]) {
+            continue;
+        }
+        int lo = text_lo[row] & ~1;
+        int hi = (text_hi[row] + 1) & ~1;
+        text_pending[row] = 1;
+        if (!dma_queue_add((void*) (screen_block(TEXT_BLOCK) + row * 32 + lo),
+                    &text_map[row][lo], (hi - lo) * 2, DMA_PRIORITY_MAP,
+                    &text_pending[row])) {
+            text_pending[row] = 0;
+            break;
+        }
+        text_dirty &= ~(1 << row);
+        text_rows_flushed++;
+    }
+}
+
+/* a number on the HUD, with the value and digit count on the screen now */
+struct HudNumber {
+    int col, row;
+
+    /* the fewest digits shown */
+    int width;
+
+    int value;
+    int length;
+};
+
+struct HudNumber hud_score = { 7, 0, 6, -1, 0 };
+struct HudNumber hud_high = { 22, 0, 6, -1, 0 };
+struct HudNumber hud_lives = { 7, 19, 1, -1, 0 };
+struct HudNumber hud_stage = { 27, 19, 1, -1, 0 };
+
+/* the row of the middle of the screen messages */
+#define BANNER_ROW 9
+
+/* the message in the middle of the screen, or null */
+const char* banner = 0;
+
+/* show a number if it has changed, with as many digits as it needs */
+void hud_number(struct HudNumber* n, int value) {
+    if (value == n->value) {
+        return;
+    }
+    int length = text_number(n->col, n->row, value, n->width);
+
+    /* blank the cells a longer number used */
+    text_clear(n->col + length, n->row, n->length - length);
+    n->value = value;
+    n->length = length;
+}
+
+/* show a message in the middle of the screen, or take it down with null */
+void hud_banner(const char* text) {
+    if (text == banner) {
+        return;
+    }
+    banner = text;
+    if (text) {
+        text_center(BANNER_ROW, text);
+    } else {
+        text_clear(0, BANNER_ROW, TEXT_COLS);
+    }
+}
+
+/* clear some rows of the text layer's screen block and of the copy of it */
+void hud_clear_rows(int first, int count) {
+    memset32((void*) (screen_block(TEXT_BLOCK) + first * 32), 0, count * 64);
+    for (int row = first; row < first + count && row < TEXT_ROWS; row++) {
+        memset32(text_map[row], 0, sizeof(text_map[row]));
+    }
+}
+
+/* write the labels and turn on background 3, once the loader has put the
+ * font in and cleared the text map */
+void setup_hud() {
+    text_print(1, 0, "SCORE");
+    text_print(19, 0, "HI");
+    text_print(1, 19, "LIVES");
+    text_print(21, 19, "STAGE");
+
+    *bg3_control = 0 |    /* priority, 0 is highest, 3 is lowest */
+        (TEXT_CHAR_BLOCK << 2) | /* the char block the image data is stored in */
+        (0 << 6)  |       /* the mosaic flag */
+        (0 << 7)  |       /* color mode, 0 is 16 colors, 1 is 256 colors */
+        (TEXT_BLOCK << 8) | /* the screen block the tile data is stored in */
+        (0 << 13) |       /* wrapping flag */
+        (0 << 14);        /* bg size, 0 is 256x256 */
+}
+
+/* bring the HUD up to date, only numbers that changed touch the map */
+void hud_update(int stage) {
+    if (SSCORE > high_score) {
+        high_score = SSCORE;
+    }
+    hud_number(&hud_score, SSCORE);
+    hud_number(&hud_high, high_score);
+    hud_number(&hud_lives, player_lives);
+    hud_number(&hud_stage, stage);
+}
+
+/* the states of the game */
+#define STATE_TITLE 0
+#define STATE_PLAY 1
+#define STATE_PAUSE 2
+#define STATE_GAME_OVER 3
+#define STATE_STAGE_CLEAR 4
+
+void state_change(int next);
+
+/* whether the game ended by beating the last formation */
+int game_won = 0;
+
+/* everything the game simulates which isn't in a global of its own */
+struct World {
+    struct Player player;
+    struct Enemy enemies[NUM_ENEMIES];
+    struct Bullet playerBullets[20];
+
+    /* the formation being fought, and the frames since the last shot */
+    int formation;
+    int firing_counter;
+};
+struct World world;
+
+/* bring the player back for another life, taking away any enemies which
+ * got to the bottom so they don't kill it again straight away */
+void player_respawn(struct Player* player) {
+    player->x = 112;
+    player->y = 144;
+    player->isAlive = 1;
+    sprite_set_frame(player->sprite, TILE_PLAYER);
+    sprite_set_palette(player->sprite, PAL_PLAYER);
+    sprite_position(player->sprite, player->x, player->y);
+
+    for (int i = 0; i < NUM_ENEMIES; i++) {
+        struct Enemy* enemy = &world.enemies[i];
+        if (enemy->isAlive && enemy->y >= HEIGHT - 12) {
+            enemy->isAlive = 0;
+            sprite_position(enemy->sprite, WIDTH, HEIGHT);
+        }
+    }
+}
+
+/* run the game for a frame */
+void play_update() {
+    struct Player* player = &world.player;
+    struct Bullet* playerBullets = world.playerBullets;
+
+    if(button_pressed(BUTTON_RIGHT) && player->x < 224 ){
+        player->x += 1;
+        sprite_move(player->sprite, 1, 0);
+    } else if (button_pressed(BUTTON_LEFT) && player->x > 0 ){
+        player->x -= 1; 
+        sprite_move(player->sprite, -1, 0);
+    } else if (button_pressed(BUTTON_SELECT)){
+       // if(bulletCount >= 5){
+        //    bulletCount = 0;
+       // }
+        for(int i = 0; i < 20; i++){
+            if(playerBullets[i].active == 0 && world.firing_counter >= 20){
+                playerBullets[i].x = player->x + 4; 
+                playerBullets[i].y = player->y -2; 
+                playerBullets[i].active = 1;
+                playerBullets[i].yvel = -1;
+                sprite_position(playerBullets[i].sprite, player->x + 4, player->y -2 );
+                world.firing_counter = 0; 
+               // bulletCount += 1;
+                break;
+            }
+        }
+       // bulletCount += 1; 
+    }        
+
+    formation_update(world.enemies, player);
+    anim_update_all();
+    player_update(player); 
+    if (!player->isAlive && !player->isExploding) {
+        if (player_lives > 0) {
+            player_respawn(player);
+        } else {
+            game_won = 0;
+            state_change(STATE_GAME_OVER);
+        }
+    }
+    enemy_cells_build(world.enemies);
+    update_bullets(playerBullets, world.enemies); 
+ //   sprite_position(player->sprite, player->x , player->y);
+
+    int beaten = formation_check(world.enemies);
+    if (beaten) {
+        if (world.formation < 7) {
+            state_change(STATE_STAGE_CLEAR);
+        } else {
+            game_won = 1;
+            state_change(STATE_GAME_OVER);
+        }
+    }
+
+    particle_update();
+    scroll_update();
+    scanline_update();
+    world.firing_counter += 1;  
+}
+
+/* a snapshot is the whole state of the game packed into one buffer from
+ * these word aligned regions, each saved and put back with its own word
+ * copy - particles are only for show and are left out, and sprites keep
+ * the tile of the sheet they show rather than where it is in VRAM, since
+ * the cache is rebuilt around them on restore
+ *
+ * the game has no random numbers, everything follows from this state and
+ * the buttons */
+struct SnapshotRegion {
+    void* data;
+    int bytes;
+};
+
+const struct SnapshotRegion snapshot_regions[] = {
+    { &world, sizeof(world) },
+    { &SSCORE, sizeof(SSCORE) },
+    { &player_lives, sizeof(player_lives) },
+    { sprites, sizeof(sprites) },
+    { &next_sprite_index, sizeof(next_sprite_index) },
+    { &next_object_index, sizeof(next_object_index) },
+    { sprite_tile, sizeof(sprite_tile) },
+    { anim_clip, sizeof(anim_clip) },
+    { anim_frame, sizeof(anim_frame) },
+    { anim_timer, sizeof(anim_timer) },
+    { anim_active, sizeof(anim_active) },
+    { anim_slot, sizeof(anim_slot) },
+    { &anim_count, sizeof(anim_count) },
+    { scroll_layers, sizeof(scroll_layers) },
+    { &stream_data, sizeof(stream_data) },
+    { &stream_row, sizeof(stream_row) },
+    { &stream_world_row, sizeof(stream_world_row) },
+    { &high_score, sizeof(high_score) },
+    { &scanline_effect, sizeof(scanline_effect) },
+    { &scanline_length, sizeof(scanline_length) },
+    { &scanline_frames, sizeof(scanline_frames) },
+    { (void*) &scanline_running, sizeof(scanline_running) },
+};
+#define SNAPSHOT_REGIONS ((int) (sizeof(snapshot_regions) / sizeof(snapshot_regions[0])))
+
+/* the size of a snapshot, the sum of the regions */
+#define SNAPSHOT_BYTES (sizeof(world) + sizeof(SSCORE) + sizeof(player_lives) + \
+        sizeof(sprites) + sizeof(next_sprite_index) + sizeof(next_object_index) + \
+        sizeof(sprite_tile) + sizeof(anim_clip) + sizeof(anim_frame) + \
+        sizeof(anim_timer) + sizeof(anim_active) + sizeof(anim_slot) + sizeof(anim_count) + \
+        sizeof(scroll_layers) + sizeof(stream_data) + sizeof(stream_row) + \
+        sizeof(stream_world_row) + sizeof(high_score) + sizeof(scanline_effect) + \
+        sizeof(scanline_length) + sizeof(scanline_frames) + sizeof(scanline_running))
+#define SNAPSHOT_WORDS ((int) (SNAPSHOT_BYTES / 4))
+
+/* snapshots and the rewind buffer are in EWRAM, left uninitialized */
+#define EWRAM_BSS __attribute__((section(".sbss"), aligned(4)))
+
+/* the game as it was when play started, for restarting */
+unsigned int restart_snapshot[SNAPSHOT_WORDS] EWRAM_BSS;
+
+/* pack the game into a snapshot */
+void snapshot_save(unsigned int* snapshot) {
+    char* dest = (char*) snapshot;
+    for (int i = 0; i < SNAPSHOT_REGIONS; i++) {
+        memcpy32(dest, snapshot_regions[i].data, snapshot_regions[i].bytes);
+        dest += snapshot_regions[i].bytes;
+    }
+}
+
+/* put the game back how it was in a snapshot */
+void snapshot_restore(const unsigned int* snapshot) {
+    /* let go of the frames the particles and sprites hold now */
+    for (int i = 0; i < particle_count; i++) {
+        vram_release(particle_frame[i]);
+    }
+    particle_count = 0;
+    for (int i = 0; i < NUM_OBJECTS; i++) {
+        vram_release(sprite_frame[i]);
+        vram_release(sprite_next[i]);
+        sprite_frame[i] = -1;
+        sprite_next[i] = -1;
+    }
+    sprite_waiting = 0;
+
+    const char* source = (const char*) snapshot;
+    for (int i = 0; i < SNAPSHOT_REGIONS; i++) {
+        memcpy32(snapshot_regions[i].data, source, snapshot_regions[i].bytes);
+        source += snapshot_regions[i].bytes;
+    }
+
+    /* make the frames resident again, most are still in the cache */
+    for (int i = 0; i < NUM_OBJECTS; i++) {
+        if (sprite_tile[i] >= 0) {
+            sprite_set_frame(&sprites[i], sprite_tile[i]);
+        }
+    }
+    oam_fresh = 1;
+    hud_banner(0);
+
+    /* a table built ahead before the restore is for the wrong frame */
+    scanline_ready = 0;
+}
+
+/* a snapshot goes in the rewind buffer every few frames, as the words that
+ * changed since the one before xored with it, in runs of a header word
+ * (unchanged words << 16 | changed words) and the changed words - xor
+ * works both ways, so the newest delta turns the latest snapshot back into
+ * the one before it
+ *
+ * the stage map has 11 rows to spare past the screen, which the stage
+ * takes about 4.4 seconds to scroll through, so rewinding stays under that
+ * and the rows below the screen haven't been streamed over yet */
+#define REWIND_INTERVAL 2
+#define REWIND_ENTRIES 120
+#define REWIND_WORDS 0x4000
+
+/* the deltas, where each one starts and its length in words */
+unsigned int rewind_buffer[REWIND_WORDS] EWRAM_BSS;
+unsigned short rewind_start[REWIND_ENTRIES];
+unsigned short rewind_length[REWIND_ENTRIES];
+
+/* the slot of the newest delta and how many there are */
+int rewind_newest = -1;
+int rewind_count = 0;
+
+/* the snapshot the newest delta leads to, and one being made */
+unsigned int rewind_last[SNAPSHOT_WORDS] EWRAM_BSS;
+unsigned int rewind_next[SNAPSHOT_WORDS] EWRAM_BSS;
+int rewind_primed = 0;
+int rewind_timer = 0;
+
+/* what rewinding costs */
+struct RewindStats {
+    /* the words the deltas take, and the last one */
+    int words;
+    int last;
+
+    /* the cycles of the last record */
+    unsigned int cycles;
+};
+struct RewindStats rewind_stats;
+
+/* forget everything recorded, after a restart */
+void rewind_reset() {
+    rewind_newest = -1;
+    rewind_count = 0;
+    rewind_primed = 0;
+    rewind_timer = 0;
+    rewind_stats.words = 0;
+}
+
+/* write the xor of two snapshots, returns its length in words */
+int rewind_encode(unsigned int* dest, const unsigned int* now, const unsigned int* last) {
+    int length = 0;
+    int i = 0;
+    while (i < SNAPSHOT_WORDS) {
+        int start = i;
+        while (i < SNAPSHOT_WORDS && now[i] == last[i]) {
+            i++;
+        }
+        int changed = i;
+        while (i < SNAPSHOT_WORDS && now[i] != last[i]) {
+            i++;
+        }
+        if (changed == SNAPSHOT_WORDS) {
+            break;
+        }
+        dest[length++] = ((changed - start) << 16) | (i - changed);
+        for (int j = changed; j < i; j++) {
+            dest[length++] = now[j] ^ last[j];
+        }
+    }
+    return length;
+}
+
+/* xor a delta into a snapshot */
+void rewind_apply(unsigned int* snapshot, const unsigned int* delta, int length) {
+    int i = 0;
+    const unsigned int* end = delta + length;
+    while (delta < end) {
+        i += *delta >> 16;
+        int changed = *delta++ & 0xffff;
+        while (changed--) {
+            snapshot[i++] ^= *delta++;
+        }
+    }
+}
+
+/* record the game every few frames, dropping the oldest deltas to make
+ * room - the buffer is never more than REWIND_WORDS */
+void rewind_record() {
+    if (++rewind_timer < REWIND_INTERVAL) {
+        return;
+    }
+    rewind_timer = 0;
+    profile_start();
+    snapshot_save(rewind_next);
+    if (rewind_primed) {
+        /* after the newest, or back at the start if the longest a delta
+         * can be doesn't fit */
+        int start = 0;
+        int wrapped = 0;
+        if (rewind_count) {
+            start = rewind_start[rewind_newest] + rewind_length[rewind_newest];
+            if (start + SNAPSHOT_WORDS + 1 > REWIND_WORDS) {
+                start = 0;
+                wrapped = 1;
+            }
         }
+        int length = rewind_encode(rewind_buffer + start, rewind_next, rewind_last);
+
+        /* drop the oldest while there are too many, they are left at the
+         * end from the lap before, or they overlap the new one */
+        while (rewind_count) {
+            int oldest = (rewind_newest - rewind_count + 1 + REWIND_ENTRIES) % REWIND_ENTRIES;
+            int from = rewind_start[oldest];
+            int tail = wrapped && from > rewind_start[rewind_newest];
+            int overlaps = from < start + length && from + rewind_length[oldest] > start;
+            if (rewind_count < REWIND_ENTRIES && !tail && !overlaps) {
+                break;
+            }
+            rewind_stats.words -= rewind_length[oldest];
+            rewind_count--;
+        }
+
+        rewind_newest = (rewind_newest + 1) % REWIND_ENTRIES;
+        rewind_start[rewind_newest] = start;
+        rewind_length[rewind_newest] = length;
+        rewind_count++;
+        rewind_stats.words += length;
+        rewind_stats.last = length;
+    }
+    memcpy32(rewind_last, rewind_next, SNAPSHOT_BYTES);
+    rewind_primed = 1;
+    rewind_stats.cycles = profile_stop();
+}
+
+/* go back one delta, or stay at the oldest once they run out */
+void rewind_step() {
+    if (!rewind_primed) {
+        return;
+    }
+    if (rewind_count) {
+        rewind_apply(rewind_last, rewind_buffer + rewind_start[rewind_newest],
+                rewind_length[rewind_newest]);
+        rewind_stats.words -= rewind_length[rewind_newest];
+        rewind_newest = (rewind_newest - 1 + REWIND_ENTRIES) % REWIND_ENTRIES;
+        rewind_count--;
     }
+    snapshot_restore(rewind_last);
+    rewind_timer = 0;
+}
+
+/* the parts of VRAM the states need, loaded a chunk a frame by asset_step */
+#define ASSET_HUD 0x01        /* the font and text layer */
+#define ASSET_STARS 0x02      /* the star tiles and layers */
+#define ASSET_STAGE 0x04      /* the stage palette and tiles */
+#define ASSET_MAP 0x08        /* the stage map from the start */
+#define ASSET_SPRITES 0x10    /* the sprite palettes */
+#define ASSET_KINDS 5
+
+/* the assets in VRAM, and the ones asked for */
+int assets_loaded = 0;
+int assets_wanted = 0;
+
+/* an asset is loaded in parts - data copied or unpacked into VRAM, the
+ * first rows of a stage map, a function run once the parts before it have
+ * landed, or a function run on a few rows of a map at a time which fills
+ * them in itself */
+#define PART_DATA 0
+#define PART_MAP 1
+#define PART_CALL 2
+#define PART_ROWS 3
+
+struct LoadPart {
+    int kind;
+    void* dest;
+    const void* source;
+    int format;
+    int bytes;
+    void (*call)();
+    void (*fill)(int first, int count);
+    int rows;
+};
+
+/* fill in a part, returns 1 */
+int load_data(struct LoadPart* p, volatile void* dest, const void* source, int format,
+        int bytes) {
+    p->kind = PART_DATA;
+    p->dest = (void*) dest;
+    p->source = source;
+    p->format = format;
+    p->bytes = bytes;
     return 1;
 }
 
-/* update an enemy formation */
-void formation_update(int formationNum, struct Enemy enemy1s[], struct Enemy enemy2s[], struct Enemy bosses[], struct Player* player) {
-    if (formationNum == 1) {
-        for (int i = 0; i < 3; i++) {
-            enemy_update(&enemy1s[i], player);
+int load_call(struct LoadPart* p, void (*call)()) {
+    p->kind = PART_CALL;
+    p->call = call;
+    return 1;
+}
+
+int load_rows(struct LoadPart* p, void (*fill)(int first, int count), int rows) {
+    p->kind = PART_ROWS;
+    p->fill = fill;
+    p->rows = rows;
+    return 1;
+}
+
+/* fill in part n of an asset, returns 0 once there are no more */
+int asset_part(int asset, int n, struct LoadPart* p) {
+    switch (asset) {
+        case ASSET_HUD:
+            switch (n) {
+                case 0: return load_data(p, bg_palette + TEXT_PALETTE * 16, Font_palette,
+                                ASSET_RAW, Font_palette_bytes);
+                case 1: return load_data(p, char_block(TEXT_CHAR_BLOCK), Font_data,
+                                Font_data_format, Font_data_bytes);
+                case 2: return load_rows(p, hud_clear_rows, 32);
+                case 3: return load_call(p, setup_hud);
+            }
+            break;
+        case ASSET_STARS:
+            switch (n) {
+                case 0: return load_call(p, setup_starfield);
+                case 1: return load_rows(p, starfield_rows, 32);
+                case 2: return load_call(p, setup_stars);
+            }
+            break;
+        case ASSET_STAGE:
+            switch (n) {
+                case 0: return load_data(p, bg_palette, SpaceBackground_palette,
+                                ASSET_RAW, STAGE_COLORS * 2);
+                case 1: return load_data(p, char_block(0), SpaceBackground_data,
+                                SpaceBackground_data_format, SpaceBackground_data_bytes);
+                case 2: return load_call(p, setup_background);
+            }
+            break;
+        case ASSET_MAP:
+            if (n == 0) {
+                p->kind = PART_MAP;
+                p->source = &stages[0];
+                return 1;
+            }
+            break;
+        case ASSET_SPRITES:
+            /* just the palettes, the image stays in the ROM and
+             * sprite_set_frame streams each frame into sprite image memory
+             * when something first shows it */
+            if (n == 0) {
+                return load_data(p, sprite_palette, Sprites_palette, ASSET_RAW,
+                        Sprites_palette_bytes);
+            }
+            break;
+    }
+    return 0;
+}
+
+/* a chunk of a part is unpacked (or map rows decoded) each frame into a
+ * copy in EWRAM, which LZ77 copies look back into, and queued for the
+ * vblank DMA - the next chunk waits until it has landed, so a load takes a
+ * bounded piece of each frame and of each vblank however big it is */
+#define LOAD_CHUNK 1024
+#define LOAD_MAP_ROWS 8
+
+/* the rows a fill part does a frame, a quarter of a screen block */
+#define LOAD_FILL_ROWS 8
+#define LOAD_BUFFER_BYTES 0x4000
+
+unsigned char load_buffer[LOAD_BUFFER_BYTES] EWRAM_BSS;
+
+/* a packed part is unpacked whole into the buffer */
+_Static_assert(Font_data_bytes <= LOAD_BUFFER_BYTES, "Font doesn't fit the load buffer");
+_Static_assert(SpaceBackground_data_bytes <= LOAD_BUFFER_BYTES,
+        "SpaceBackground doesn't fit the load buffer");
+
+/* the load under way */
+struct Loader {
+    /* the asset (0 if none), which part and that part */
+    int asset;
+    int part;
+    struct LoadPart current;
+    int part_done;
+
+    /* the bytes (or map rows) unpacked so far, and how many of them are
+     * queued (or the rows a fill part has done) - a packed part queues
+     * whole words, so the odd bytes of a chunk wait in the buffer for the
+     * next one */
+    int unpacked;
+    int queued;
+
+    /* where the unpacking is in the source, and the LZ77 block flags */
+    const unsigned char* source;
+    unsigned char flags;
+    int flag_bits;
+
+    /* the first map row of the last rows decoded, and how many */
+    int map_low;
+    int map_rows;
+
+    /* set while the last chunk waits for vblank */
+    volatile int pending;
+};
+struct Loader loader;
+
+/* what loading costs */
+struct LoadStats {
+    /* the frames the last asset took */
+    int frames;
+
+    /* the cycles of the last frame that loaded, and the most ever */
+    unsigned int cycles;
+    unsigned int worst;
+
+    /* the cycles of every frame of the asset under way added up, and
+     * what each asset took in all the last time it loaded, by its bit -
+     * this is what the boot copies cost */
+    unsigned int total;
+    unsigned int asset_cycles[ASSET_KINDS];
+};
+struct LoadStats load_stats;
+
+/* unpack whole runs (or LZ77 blocks) of the BIOS formats into the load
+ * buffer until at least limit bytes are out */
+void load_unpack(int limit) {
+    const unsigned char* source = loader.source;
+    unsigned char* out = load_buffer;
+    int n = loader.unpacked;
+    if (loader.current.format == ASSET_RL) {
+        while (n < limit) {
+            int flag = *source++;
+            if (flag & 0x80) {
+                int length = (flag & 0x7f) + 3;
+                unsigned char value = *source++;
+                while (length--) {
+                    out[n++] = value;
+                }
+            } else {
+                int length = flag + 1;
+                while (length--) {
+                    out[n++] = *source++;
+                }
+            }
         }
-    } else if (formationNum == 2) {
-        for (int i = 0; i < 6; i++) {
-            enemy_update(&enemy1s[i], player);
+    } else {
+        while (n < limit) {
+            if (loader.flag_bits == 0) {
+                loader.flags = *source++;
+                loader.flag_bits = 8;
+            }
+            loader.flag_bits--;
+            if (loader.flags & 0x80) {
+                int length = (source[0] >> 4) + 3;
+                int back = (((source[0] & 0xf) << 8) | source[1]) + 1;
+                source += 2;
+                while (length--) {
+                    out[n] = out[n - back];
+                    n++;
+                }
+            } else {
+                out[n++] = *source++;
+            }
+            loader.flags <<= 1;
         }
-    } else if (formationNum == 3) {
-        for (int i = 0; i < 9; i++) {
-            enemy_update(&enemy1s[i], player);
+    }
+    loader.source = source;
+    loader.unpacked = n;
+}
+
+/* queue some bytes for vblank, returns 0 if the queue is full so the part
+ * stays where it is and tries again next frame */
+int load_queue(void* dest, const void* source, int bytes) {
+    loader.pending = 1;
+    if (!dma_queue_add(dest, source, bytes, DMA_PRIORITY_TILES, &loader.pending)) {
+        loader.pending = 0;
+        return 0;
+    }
+    return 1;
+}
+
+/* the end of what a packed part can queue, whole words until the last */
+int load_data_end(struct LoadPart* p) {
+    return loader.unpacked >= p->bytes ? p->bytes : loader.unpacked & ~3;
+}
+
+/* unpack and queue the next chunk of a data part */
+void load_data_step(struct LoadPart* p) {
+    if (p->format == ASSET_RAW) {
+        int bytes = p->bytes - loader.queued;
+        if (bytes > LOAD_CHUNK) {
+            bytes = LOAD_CHUNK;
         }
-    } else if (formationNum == 4) {
-        for (int i = 0; i < 8; i++) {
-            enemy_update(&enemy1s[i], player);
+        if (load_queue((char*) p->dest + loader.queued,
+                (const char*) p->source + loader.queued, bytes)) {
+            loader.queued += bytes;
+        }
+    } else {
+        /* unpack another chunk once the last is queued */
+        if (load_data_end(p) == loader.queued) {
+            int limit = loader.unpacked + LOAD_CHUNK;
+            load_unpack(limit < p->bytes ? limit : p->bytes);
         }
-        for (int i = 0; i < 5; i++) {
-            enemy_update(&enemy2s[i], player);
+        int end = load_data_end(p);
+        if (load_queue((char*) p->dest + loader.queued, load_buffer + loader.queued,
+                end - loader.queued)) {
+            loader.queued = end;
         }
-    } else if (formationNum == 5) {
-        for (int i = 0; i < 7; i++) {
-            enemy_update(&enemy1s[i], player);
+    }
+    if (loader.queued == p->bytes) {
+        loader.part_done = 1;
+    }
+}
+
+/* decode and queue the next few rows of a stage, the rows of a chunk go
+ * in adjacent map rows so they are one transfer */
+void load_map_step(struct LoadPart* p) {
+    if (loader.queued == 0 && loader.unpacked == 0) {
+        /* let a row on its way to the map land first */
+        if (stream_pending) {
+            return;
         }
-        for (int i = 0; i < 9; i++) {
-            enemy_update(&enemy2s[i], player);
+        stage_start(p->source);
+    }
+    unsigned short* buffer = (unsigned short*) load_buffer;
+
+    /* decode rows unless the last ones didn't fit in the queue */
+    if (loader.unpacked == loader.queued) {
+        int slot = stream_world_row & 31;
+        int rows = 32 - loader.queued;
+        if (rows > LOAD_MAP_ROWS) {
+            rows = LOAD_MAP_ROWS;
         }
-    } else if (formationNum == 6) {
-        for (int i = 0; i < 8; i++) {
-            enemy_update(&enemy1s[i], player);
+        if (rows > slot + 1) {
+            rows = slot + 1;
         }
-        for (int i = 0; i < 16; i++) {
-            enemy_update(&enemy2s[i], player);
+        for (int i = 0; i < rows; i++) {
+            stream_decode(buffer + tile_index_pow2(0, stream_world_row--, 32, 32));
         }
-    } else if (formationNum == 7) {
-        for (int i = 0; i < 17; i++) {
-            enemy_update(&enemy1s[i], player);
+        loader.unpacked += rows;
+        loader.map_low = slot - rows + 1;
+        loader.map_rows = rows;
+    }
+    if (load_queue((void*) (screen_block(STAGE_BLOCK) + loader.map_low * 32),
+            buffer + loader.map_low * 32, loader.map_rows * 64)) {
+        loader.queued = loader.unpacked;
+    }
+    if (loader.queued == 32) {
+        loader.part_done = 1;
+    }
+}
+
+/* run a fill part on its next few rows */
+void load_rows_step(struct LoadPart* p) {
+    int count = p->rows - loader.queued;
+    if (count > LOAD_FILL_ROWS) {
+        count = LOAD_FILL_ROWS;
+    }
+    p->fill(loader.queued, count);
+    loader.queued += count;
+    if (loader.queued == p->rows) {
+        loader.part_done = 1;
+    }
+}
+
+/* ask for some assets to be loaded ahead of when they're needed */
+void asset_want(int assets) {
+    assets_wanted |= assets;
+}
+
+/* whether all of some assets are in VRAM */
+int assets_ready(int assets) {
+    return (assets_loaded & assets) == assets;
+}
+
+/* do the next chunk of loading, starting on the next asset wanted if
+ * there isn't one under way - an asset is ready once its last chunk has
+ * landed */
+void asset_step() {
+    if (!loader.asset) {
+        int missing = assets_wanted & ~assets_loaded;
+        if (!missing) {
+            return;
+        }
+        loader.asset = missing & -missing;
+        loader.part = -1;
+        loader.part_done = 1;
+        load_stats.frames = 0;
+        load_stats.total = 0;
+    }
+    load_stats.frames++;
+    if (loader.pending) {
+        return;
+    }
+
+    profile_start();
+    struct LoadPart* p = &loader.current;
+    if (loader.part_done) {
+        if (!asset_part(loader.asset, ++loader.part, p)) {
+            load_stats.cycles = profile_stop();
+            load_stats.total += load_stats.cycles;
+            load_stats.asset_cycles[__builtin_ctz(loader.asset)] = load_stats.total;
+            assets_loaded |= loader.asset;
+            loader.asset = 0;
+            return;
         }
-        for (int i = 0; i < 9; i++) {
-            enemy_update(&enemy2s[i], player);
+        loader.part_done = 0;
+        loader.unpacked = 0;
+        loader.queued = 0;
+        loader.flag_bits = 0;
+        loader.source = (const unsigned char*) p->source + (p->format == ASSET_RAW ? 0 : 4);
+    }
+    switch (p->kind) {
+        case PART_DATA: load_data_step(p); break;
+        case PART_MAP: load_map_step(p); break;
+        case PART_CALL: p->call(); loader.part_done = 1; break;
+        case PART_ROWS: load_rows_step(p); break;
+    }
+    load_stats.cycles = profile_stop();
+    load_stats.total += load_stats.cycles;
+    if (load_stats.cycles > load_stats.worst) {
+        load_stats.worst = load_stats.cycles;
+    }
+}
+
+/* the display layers showing a set of assets */
+unsigned short asset_layers(int assets) {
+    unsigned short layers = MODE0 | SPRITE_MAP_1D;
+    if (assets & ASSET_HUD) {
+        layers |= BG3_ENABLE;
+    }
+    if (assets & ASSET_STARS) {
+        layers |= BG1_ENABLE | BG2_ENABLE;
+    }
+    if ((assets & (ASSET_STAGE | ASSET_MAP)) == (ASSET_STAGE | ASSET_MAP)) {
+        layers |= BG0_ENABLE;
+    }
+    if (assets & ASSET_SPRITES) {
+        layers |= SPRITE_ENABLE;
+    }
+    return layers;
+}
+
+/* a state of the game - enter runs once on the way in, then update and
+ * draw (either may be null) every frame - a state isn't entered until its
+ * assets are ready */
+struct GameState {
+    void (*enter)();
+    void (*update)();
+    void (*draw)();
+    int assets;
+};
+
+/* the assets of a state with the game on the screen */
+#define ASSETS_GAME (ASSET_HUD | ASSET_STARS | ASSET_STAGE | ASSET_MAP | ASSET_SPRITES)
+
+/* the state running (-1 before the first), the one waiting on its assets
+ * (-1 if none), and the frames since the state was entered */
+int state = -1;
+int state_next = -1;
+int state_timer = 0;
+
+/* how long the stage clear message stays up */
+#define STAGE_CLEAR_FRAMES 90
+
+/* blank the text between the HUD lines */
+void text_clear_middle() {
+    for (int row = 1; row < TEXT_ROWS - 1; row++) {
+        text_clear(0, row, TEXT_COLS);
+    }
+    banner = 0;
+}
+
+/* put everything back the way it was at boot for a new game, the map has
+ * been streamed over so it is loaded again */
+void game_reset() {
+    snapshot_restore(restart_snapshot);
+    rewind_reset();
+    assets_loaded &= ~ASSET_MAP;
+    scanline_start(SCANLINE_WARP, 60);
+}
+
+/* the title, with the best scores, preloading the game behind it */
+void title_enter() {
+    text_clear_middle();
+    text_center(3, "GALAGA");
+    for (int i = 0; i < 5; i++) {
+        const struct ScoreEntry* e = &scores.entries[i];
+        char name[SCORE_NAME + 1];
+        for (int j = 0; j < SCORE_NAME; j++) {
+            name[j] = e->name[j];
         }
-        enemy_update(&bosses[0], player);
+        name[SCORE_NAME] = 0;
+        text_number(8, 6 + i * 2, i + 1, 1);
+        text_print(11, 6 + i * 2, name);
+        text_number(16, 6 + i * 2, e->score, 6);
+    }
+    text_center(17, "PRESS START");
+    asset_want(ASSETS_GAME);
+}
+
+void title_update() {
+    if (state_next < 0 && button_tapped(BUTTON_START)) {
+        game_reset();
+        state_change(STATE_PLAY);
+    }
+}
+
+void play_enter() {
+    text_clear_middle();
+}
+
+/* play, or rewind while L is held */
+void play_state_update() {
+    if (button_tapped(BUTTON_START)) {
+        state_change(STATE_PAUSE);
+    } else if (button_pressed(BUTTON_L)) {
+        rewind_step();
+    } else {
+        play_update();
+        rewind_record();
+    }
+}
+
+void play_draw() {
+    mux_draw();
+    hud_update(world.formation);
+}
+
+void pause_enter() {
+    hud_banner("PAUSED");
+}
+
+void pause_update() {
+    if (button_tapped(BUTTON_START)) {
+        state_change(STATE_PLAY);
+    }
+}
+
+/* the end of a game, win or lose, which puts the score in the table */
+void game_over_enter() {
+    hud_banner(game_won ? "YOU WIN!" : "GAME OVER");
+    hud_update(world.formation);
+    score_submit(world.formation);
+}
+
+void game_over_update() {
+    if (button_tapped(BUTTON_START)) {
+        state_change(STATE_TITLE);
     }
 }
 
-int getOffsetForNum(int i);
+/* a pause between formations, with the explosions and stars carrying on */
+void stage_clear_enter() {
+    hud_banner("STAGE CLEAR");
+}
+
+void stage_clear_update() {
+    anim_update_all();
+    player_update(&world.player);
+    particle_update();
+    scroll_update();
+    scanline_update();
+    if (state_timer == STAGE_CLEAR_FRAMES) {
+        world.formation++;
+        spawn_EnemyFormation(world.formation, world.enemies);
+        scanline_start(SCANLINE_STRETCH, 30);
+        state_change(STATE_PLAY);
+    }
+}
+
+/* the states, indexed by the STATE_ numbers */
+const struct GameState states[] = {
+    { title_enter, title_update, 0, ASSET_HUD | ASSET_STARS },
+    { play_enter, play_state_update, play_draw, ASSETS_GAME },
+    { pause_enter, pause_update, 0, ASSETS_GAME },
+    { game_over_enter, game_over_update, 0, ASSETS_GAME },
+    { stage_clear_enter, stage_clear_update, play_draw, ASSETS_GAME },
+};
+
+/* go to another state once its assets are in, starting on any missing */
+void state_change(int next) {
+    state_next = next;
+    asset_want(states[next].assets);
+}
+
+/* the blend registers, which fade the screen to black */
+volatile unsigned short* blend_control = (volatile unsigned short*) 0x4000050;
+volatile unsigned short* blend_brightness = (volatile unsigned short*) 0x4000054;
+
+/* darken every layer and the backdrop */
+#define BLEND_DARKEN (0x3f | (3 << 6))
+#define FADE_STEPS 16
+
+/* how dark the screen is, and whether it is going dark or coming back */
+int fade_level = 0;
+int fade_out = 0;
+
+/* move the fade a step, called at the start of the frame */
+void fade_update() {
+    if (fade_out && fade_level < FADE_STEPS) {
+        fade_level++;
+    } else if (!fade_out && fade_level > 0) {
+        fade_level--;
+    }
+    *blend_control = fade_level ? BLEND_DARKEN : 0;
+    *blend_brightness = fade_level;
+}
 
-/*updates the sprites the score is displaying*/
-void updateScore(struct Score* s){
-    int score=SSCORE;
-    int thous=score/1000;
-    int hunds=(score/100)%10;
-    int tens=(score/10)%10;
-    int ones=score%10;
-    sprite_set_offset(s->thous,getOffsetForNum(thous));
-    sprite_set_offset(s->hunds,getOffsetForNum(hunds));
-    sprite_set_offset(s->tens,getOffsetForNum(tens));
-    sprite_set_offset(s->ones,getOffsetForNum(ones));
+/* enter the waiting state if its assets are all in - if it has to wait
+ * for them, the screen fades out while they load and the state is entered
+ * once it is black, then fades back in */
+void state_switch() {
+    if (state_next < 0) {
+        return;
+    }
+    const struct GameState* next = &states[state_next];
+    if (!assets_ready(next->assets)) {
+        fade_out = 1;
+        return;
+    }
+    if (fade_out && fade_level < FADE_STEPS) {
+        return;
+    }
+    fade_out = 0;
+    state = state_next;
+    state_next = -1;
+    state_timer = 0;
+    *display_control = asset_layers(next->assets);
+    if (next->enter) {
+        next->enter();
+    }
 }
 
 /* the main function */
 int main() {
-    /* we set the mode to mode 0 with bg0 on */
-    *display_control = MODE0 | BG0_ENABLE | SPRITE_ENABLE | SPRITE_MAP_1D; 
-        /* we don't use BG1 yet | BG1_ENABLE;*/
-
-    /* setup the background 0 */
-    setup_background();
+    /* nothing is shown until the first state's assets are in */
+    *display_control = MODE0 | SPRITE_MAP_1D;
 
-    setup_sprite_image();
+    save_load();
     sprite_clear();
-    struct Player player;
-    player_init(&player);
-
-    struct Enemy enemy1s[20];
-    initializeAll_Enemy1(enemy1s, 20);
-    struct Enemy enemy2s[20];
-    initializeAll_Enemy2(enemy2s, 20);
-    struct Enemy bosses[3];
-    initializeAll_Boss(bosses, 3);
-    
-    struct Bullet playerBullets[20];
+    affine_setup();
+    player_init(&world.player);
+
+    initializeAll_Enemies(world.enemies, NUM_ENEMIES);
     
-    init_bullets(playerBullets, 20);
+    init_bullets(world.playerBullets, 20);
 
     //struct Bullet eBullet;
-    //bullet_init(&eBullet,136,64,EnemyBullet);
+    //bullet_init(&eBullet,136,64,TILE_ENEMYBULLET,PAL_ENEMYBULLET);
 
-    struct Score score;
-    score_init(&score,0,5);
+    /* spawn the first enemy formation, and keep the game as it is now for
+     * starting each new one */
+    world.formation = 1;
+    world.firing_counter = 0;
+    spawn_EnemyFormation(world.formation, world.enemies);
+    snapshot_save(restart_snapshot);
 
-    /* spawn the first enemy formation */
-    int currFormation = 1;
-    spawn_EnemyFormation(currFormation, enemy1s, enemy2s, bosses);
+    setup_interrupts();
+    state_change(STATE_TITLE);
 
-    /* set initial scroll to 0 */
-    int xscroll = 0;
-    int yscroll = 0;
-    int scrollCount = 0;
-    int bulletCount = 0;
     /* loop forever */
-    int firingCounter = 0;
     while (1) {
-        //player_update(&player); 
-
-        if(button_pressed(BUTTON_RIGHT) && player.x < 224 ){
-            player.x += 1;
-            sprite_move(player.sprite, 1, 0);
-        } else if (button_pressed(BUTTON_LEFT) && player.x > 0 ){
-            player.x -= 1; 
-            sprite_move(player.sprite, -1, 0);
-        } else if (button_pressed(BUTTON_SELECT)){
-           // if(bulletCount >= 5){
-            //    bulletCount = 0;
-           // }
-            for(int i = 0; i < 20; i++){
-                if(playerBullets[i].active == 0 && firingCounter >= 20){
-                    playerBullets[i].x = player.x + 4; 
-                    playerBullets[i].y = player.y -2; 
-                    playerBullets[i].active = 1;
-                    playerBullets[i].yvel = -1;
-                    sprite_position(playerBullets[i].sprite, player.x + 4, player.y -2 );
-                    firingCounter = 0; 
-                   // bulletCount += 1;
-                    break;
-                }
-            }
-           // bulletCount += 1; 
-        }        
-
-        formation_update(currFormation, enemy1s, enemy2s, bosses, &player);
-        updateScore(&score);
-
-        player_update(&player); 
-        update_bullets(playerBullets, enemy1s, enemy2s, bosses); 
-     //   sprite_position(player.sprite, player.x , player.y);
-
-        int beaten = formation_check(currFormation, enemy1s, enemy2s, bosses);
-        if (beaten) {
-            if (currFormation < 7) {
-                currFormation++;
-                spawn_EnemyFormation(currFormation, enemy1s, enemy2s, bosses);
-            } else {
-                // you win!
-            }
+        fade_update();
+        buttons_poll();
+        if (state >= 0) {
+            states[state].update();
         }
+        state_switch();
+        sprite_land_frames();
+        if (state >= 0 && states[state].draw) {
+            states[state].draw();
+        }
+        state_timer++;
 
-        scrollBG0(&xscroll,&yscroll,&scrollCount);
+        if (assets_loaded & ASSET_MAP) {
+            stream_update();
+        }
+        asset_step();
+        text_flush();
+        save_update();
         /* set on screen position */
         sprite_update_all();
 
-        /* wait for vblank before scrolling */
-        wait_vblank();
-        firingCounter += 1;  
-        /* delay some */
-        delay(200);
+        /* sleep until vblank, the interrupt handler does the scrolling */
+        halt_vblank();
     }
 }
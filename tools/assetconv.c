@@ -0,0 +1,1012 @@
+/*
+ * assetconv.c
+ * host tool which converts the game's PNG images into binary tile and
+ * palette blobs, an assembly file which links them into the ROM with
+ * .incbin, and a header with an enum of the tile index of every sprite
+ *
+ * the sprites of a sheet are packed in 1D sprite mapping order by size
+ * class, biggest first, keeping manifest order within a class, and each
+ * is padded to the smallest sprite size the GBA has that fits it
+ *
+ * a 4bpp sheet gives each sprite one of 16 palette banks of 15 colors,
+ * sprites whose colors fit together share a bank, and the header gets an
+ * enum of the bank of every sprite alongside the tiles - the sprites
+ * between group and end always share one bank, for frames or digits which
+ * are swapped on one sprite by changing only its tile index
+ *
+ * a sprite of a 4bpp sheet with more than 15 colors, or a group with more
+ * between them, or one no bank has room for, stays 8bpp - those take the
+ * 256 color palette entries after the banks, are packed first so they
+ * start on the even tile index 8bpp needs, and the header gets
+ * <sheet>_8bpp_tiles, the tile index below which sprites are 8bpp - a
+ * sprite whose colors don't all fit in the palette fails the conversion
+ * rather than being drawn with the nearest ones
+ *
+ * build: gcc -O2 -o assetconv tools/assetconv.c -lpng
+ * usage: assetconv assets.txt assets
+ *
+ * the manifest has one line per image, blank lines and # comments are
+ * skipped:
+ *   sheet <name> [4|8]                   start a sprite sheet, 8bpp by default
+ *   <sprite> <png> [x y w h]             add a sprite (or part of a png)
+ *   group ... end                        keep these sprites in one bank
+ *   background <name> <png>              convert a whole background image
+ *   map <name> <header> <first row>      a map of the last background
+ *   font <name> <png>                    a 4bpp font, 16 glyphs a row from ' '
+ *   compress <auto|lz77|rl|raw>          how to store the tiles that follow
+ *
+ * a background's tiles are deduplicated, a tile which is a copy of an
+ * earlier one, flipped or not, is dropped and the maps listed after it are
+ * rewritten to use the earlier tile with the flip bits set - a map is read
+ * from the C array in a tile editor header, 32 entries a row, and written
+ * as run length encoded rows (a count then an entry) in the order they
+ * scroll onto the screen, from first row upwards
+ *
+ * tile data can be stored in the BIOS's LZ77 or run length formats, which
+ * the game unpacks a chunk a frame with its own decoder - auto tries both,
+ * checks each with the decoders here, and keeps the smaller one, or the
+ * raw tiles if packing saves less than an eighth, since unpacking costs
+ * CPU time while loading
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <png.h>
+
+/* palettes are 256 colors in 8bpp, and 16 banks of 16 colors in 4bpp */
+#define PALETTE_SIZE 256
+#define BANK_SIZE 16
+#define NUM_BANKS 16
+
+/* the most sprites in a sheet */
+#define MAX_SPRITES 128
+
+/* the flip bits of a background map entry */
+#define MAP_HFLIP 0x0400
+#define MAP_VFLIP 0x0800
+
+/* the most tiles a background image can have before deduplication */
+#define MAX_TILES 1024
+
+/* a loaded image as 8 bit RGBA */
+struct Image {
+    int width, height;
+    unsigned char* pixels;
+};
+
+/* a palette being built, index 0 is kept for transparency */
+struct Palette {
+    unsigned short colors[PALETTE_SIZE];
+    int count;
+
+    /* how many colors it can hold, PALETTE_SIZE or BANK_SIZE */
+    int size;
+
+    /* whether black pixels are see through, true for sprites */
+    int black_transparent;
+
+    /* pixels given the nearest color because the palette was full */
+    int approximated;
+};
+
+/* a sprite in the current sheet */
+struct Sprite {
+    char name[128];
+
+    /* the image and the part of it this sprite is */
+    struct Image image;
+    int x, y, w, h;
+
+    /* the hardware sprite size it is padded to */
+    int width, height;
+
+    /* the first tile index, counted in 4bpp tile units like OAM does */
+    int tile;
+
+    /* 4 or 8 bits per pixel, the palette bank of a 4bpp sprite, and its
+     * group or 0 */
+    int bpp;
+    int bank;
+    int group;
+
+    /* its place in the manifest, to keep the sort stable */
+    int order;
+};
+
+/* the sprite sizes the GBA has, smallest first */
+const int obj_sizes[12][2] = {
+    {8, 8}, {16, 8}, {8, 16}, {16, 16}, {32, 8}, {8, 32},
+    {32, 16}, {16, 32}, {32, 32}, {64, 32}, {32, 64}, {64, 64}
+};
+
+/* the sheet or background being written */
+struct Sheet {
+    char name[96];
+
+    /* the size in pixels of a background, padded to whole tiles */
+    int width, height;
+
+    struct Palette palette;
+
+    /* how its tiles are stored, from the compress line before it */
+    int compress;
+
+    /* whether it is a font, one 16 color bank of glyphs in character order */
+    int font;
+
+    /* 4 or 8 bits per pixel, and the banks of a 4bpp sheet */
+    int bpp;
+    struct Palette banks[NUM_BANKS];
+    int bank_count;
+
+    /* the tile units of a sprite sheet's 8bpp sprites, which come first */
+    int tiles_8bpp;
+
+    unsigned char* data;
+    int bytes;
+
+    /* for a background, the tile and flip bits each tile of the image
+     * became, and how many tiles there were before deduplication */
+    unsigned short remap[MAX_TILES];
+    int tiles;
+
+    struct Sprite sprites[MAX_SPRITES];
+    int count;
+};
+
+/* the ways tile data can be stored, the values are the BIOS header types */
+#define ASSET_RAW 0x00
+#define ASSET_LZ77 0x10
+#define ASSET_RL 0x30
+#define ASSET_AUTO -1
+
+/* how the tiles that follow are stored */
+int compress_mode = ASSET_AUTO;
+
+/* the files being generated */
+FILE* header;
+FILE* assembly;
+const char* out_dir;
+
+/* read a png into 8 bit RGBA */
+int image_load(struct Image* image, const char* file) {
+    png_image png;
+    memset(&png, 0, sizeof(png));
+    png.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_file(&png, file)) {
+        fprintf(stderr, "assetconv: %s: %s\n", file, png.message);
+        return 0;
+    }
+    png.format = PNG_FORMAT_RGBA;
+    image->width = png.width;
+    image->height = png.height;
+    image->pixels = malloc(PNG_IMAGE_SIZE(png));
+    if (!png_image_finish_read(&png, NULL, image->pixels, 0, NULL)) {
+        fprintf(stderr, "assetconv: %s: %s\n", file, png.message);
+        free(image->pixels);
+        return 0;
+    }
+    return 1;
+}
+
+/* the squared distance between two 15 bit colors */
+int color_distance(unsigned short a, unsigned short b) {
+    int dr = (a & 31) - (b & 31);
+    int dg = ((a >> 5) & 31) - ((b >> 5) & 31);
+    int db = ((a >> 10) & 31) - ((b >> 10) & 31);
+    return dr * dr + dg * dg + db * db;
+}
+
+/* a pixel as a 15 bit BGR color, the GBA's format, or -1 if it is
+ * transparent - pixels outside the image, see through pixels and magenta
+ * are, and anything which is black at 15 bits if black_transparent */
+int pixel_color(const struct Image* image, int x, int y, int black_transparent) {
+    if (x >= image->width || y >= image->height) {
+        return -1;
+    }
+    const unsigned char* p = &image->pixels[(y * image->width + x) * 4];
+    if (p[3] < 128 || (p[0] == 0xff && p[1] == 0 && p[2] == 0xff)) {
+        return -1;
+    }
+    int color = (p[0] >> 3) | ((p[1] >> 3) << 5) | ((p[2] >> 3) << 10);
+    if (black_transparent && color == 0) {
+        return -1;
+    }
+    return color;
+}
+
+/* find a pixel's palette index, adding the color if it is new or taking
+ * the nearest one if the palette is full */
+int palette_index(struct Palette* palette, const struct Image* image, int x, int y) {
+    int color = pixel_color(image, x, y, palette->black_transparent);
+    if (color < 0) {
+        return 0;
+    }
+    for (int i = 1; i < palette->count; i++) {
+        if (palette->colors[i] == color) {
+            return i;
+        }
+    }
+    if (palette->count < palette->size) {
+        palette->colors[palette->count] = color;
+        return palette->count++;
+    }
+
+    int best = 1;
+    for (int i = 2; i < palette->count; i++) {
+        if (color_distance(palette->colors[i], color) <
+                color_distance(palette->colors[best], color)) {
+            best = i;
+        }
+    }
+    palette->approximated++;
+    return best;
+}
+
+/* append a w x h region of an image as tiles, left to right then top to
+ * bottom, which is the order 1D sprite mapping reads them in, padded with
+ * transparency out to out_w x out_h - 4bpp tiles keep the left pixel of
+ * each pair in the low nibble */
+void sheet_add_tiles(struct Sheet* sheet, int bpp, struct Palette* palette,
+        const struct Image* image, int x0, int y0, int w, int h, int out_w, int out_h) {
+    int tiles_w = out_w / 8;
+    int tiles_h = out_h / 8;
+    int tile_bytes = bpp * 8;
+    sheet->data = realloc(sheet->data, sheet->bytes + tiles_w * tiles_h * tile_bytes);
+    unsigned char* dest = sheet->data + sheet->bytes;
+    memset(dest, 0, tiles_w * tiles_h * tile_bytes);
+    for (int ty = 0; ty < tiles_h; ty++) {
+        for (int tx = 0; tx < tiles_w; tx++) {
+            for (int y = 0; y < 8; y++) {
+                for (int x = 0; x < 8; x++) {
+                    int px = tx * 8 + x;
+                    int py = ty * 8 + y;
+                    int index = 0;
+                    if (px < w && py < h) {
+                        index = palette_index(palette, image, x0 + px, y0 + py);
+                    }
+                    if (bpp == 4) {
+                        dest[(y * 8 + x) / 2] |= index << ((x & 1) * 4);
+                    } else {
+                        dest[y * 8 + x] = index;
+                    }
+                }
+            }
+            dest += tile_bytes;
+        }
+    }
+    sheet->bytes += tiles_w * tiles_h * tile_bytes;
+}
+
+/* the flip bits which turn 8bpp tile b into tile a, or -1 if no flip does */
+int tile_flip(const unsigned char* a, const unsigned char* b) {
+    for (int flip = 0; flip < 4; flip++) {
+        int same = 1;
+        for (int y = 0; y < 8 && same; y++) {
+            for (int x = 0; x < 8 && same; x++) {
+                int bx = (flip & 1) ? 7 - x : x;
+                int by = (flip & 2) ? 7 - y : y;
+                same = a[y * 8 + x] == b[by * 8 + bx];
+            }
+        }
+        if (same) {
+            return flip;
+        }
+    }
+    return -1;
+}
+
+/* drop the background tile just added if an earlier one matches it in some
+ * orientation, and remember which tile and flip it became */
+void sheet_dedup_tile(struct Sheet* sheet) {
+    unsigned char* tile = sheet->data + sheet->bytes - 64;
+    int count = sheet->bytes / 64 - 1;
+    for (int i = 0; i < count; i++) {
+        int flip = tile_flip(tile, sheet->data + i * 64);
+        if (flip >= 0) {
+            sheet->remap[sheet->tiles++] = i | (flip * MAP_HFLIP);
+            sheet->bytes -= 64;
+            return;
+        }
+    }
+    sheet->remap[sheet->tiles++] = count;
+}
+
+/* the colors of a sprite, or of every sprite in its group, most used
+ * first, or -1 if there are more than a bank holds */
+int sprite_colors(const struct Sheet* sheet, const struct Sprite* sprite, unsigned short* colors) {
+    static int uses[0x8000];
+    memset(uses, 0, sizeof(uses));
+    for (int i = 0; i < sheet->count; i++) {
+        const struct Sprite* s = &sheet->sprites[i];
+        if (s != sprite && (!sprite->group || s->group != sprite->group)) {
+            continue;
+        }
+        for (int y = 0; y < s->h; y++) {
+            for (int x = 0; x < s->w; x++) {
+                int color = pixel_color(&s->image, s->x + x, s->y + y, 1);
+                if (color >= 0) {
+                    uses[color]++;
+                }
+            }
+        }
+    }
+    int count = 0;
+    while (count < BANK_SIZE - 1) {
+        int best = -1;
+        for (int c = 0; c < 0x8000; c++) {
+            if (uses[c] && (best < 0 || uses[c] > uses[best])) {
+                best = c;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+        colors[count++] = best;
+        uses[best] = 0;
+    }
+    for (int c = 0; c < 0x8000; c++) {
+        if (uses[c]) {
+            return -1;
+        }
+    }
+    return count;
+}
+
+/* put a 4bpp sprite in the bank of its group if that has been picked,
+ * otherwise in the first bank which has room for the colors it is
+ * missing, or a new bank - returns -1 if its colors don't fit in a bank
+ * or every bank is full, and it has to be 8bpp */
+int sheet_bank(struct Sheet* sheet, const struct Sprite* s) {
+    for (int i = 0; i < sheet->count && s->group; i++) {
+        const struct Sprite* other = &sheet->sprites[i];
+        if (other != s && other->group == s->group && other->bank >= 0) {
+            return other->bank;
+        }
+    }
+
+    unsigned short colors[BANK_SIZE];
+    int count = sprite_colors(sheet, s, colors);
+    if (count < 0) {
+        return -1;
+    }
+
+    for (int b = 0; b <= sheet->bank_count && b < NUM_BANKS; b++) {
+        struct Palette* bank = &sheet->banks[b];
+        if (b == sheet->bank_count) {
+            bank->colors[0] = 0x7c1f;
+            bank->count = 1;
+            bank->size = BANK_SIZE;
+            bank->black_transparent = 1;
+            sheet->bank_count++;
+        }
+
+        int missing = 0;
+        for (int i = 0; i < count; i++) {
+            int found = 0;
+            for (int j = 1; j < bank->count; j++) {
+                found |= bank->colors[j] == colors[i];
+            }
+            missing += !found;
+        }
+        if (bank->count + missing > BANK_SIZE) {
+            continue;
+        }
+        for (int i = 0; i < count; i++) {
+            int found = 0;
+            for (int j = 1; j < bank->count; j++) {
+                found |= bank->colors[j] == colors[i];
+            }
+            if (!found) {
+                bank->colors[bank->count++] = colors[i];
+            }
+        }
+        return b;
+    }
+    return -1;
+}
+
+/* write a block of bytes to out_dir/name */
+void write_blob(const char* name, const void* data, int bytes) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", out_dir, name);
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        perror(path);
+        exit(1);
+    }
+    fwrite(data, 1, bytes, f);
+    fclose(f);
+}
+
+/* link a blob into the ROM and declare it in the header */
+void emit_blob(const char* symbol, const char* file, const char* type, int bytes) {
+    fprintf(assembly, "\n.global %s\n.align 2\n%s:\n    .incbin \"%s/%s\"\n",
+            symbol, symbol, out_dir, file);
+    fprintf(header, "extern const %s %s[];\n", type, symbol);
+    fprintf(header, "#define %s_bytes %d\n", symbol, bytes);
+}
+
+/* write the 4 byte BIOS header, the type and the unpacked size */
+int pack_header(unsigned char* out, int type, int bytes) {
+    out[0] = type;
+    out[1] = bytes;
+    out[2] = bytes >> 8;
+    out[3] = bytes >> 16;
+    return 4;
+}
+
+/* pack in the BIOS LZ77 format: blocks of 8 items after a flag byte, top
+ * bit first, a set bit is a 2 byte copy of 3 to 18 bytes from 1 to 4096
+ * back - copies from 1 back are never used, since LZ77UnCompVram writes
+ * halfwords and can't read the byte it is still holding */
+int lz77_pack(const unsigned char* in, int bytes, unsigned char* out) {
+    int length = pack_header(out, ASSET_LZ77, bytes);
+    int pos = 0;
+    while (pos < bytes) {
+        int flags = length++;
+        out[flags] = 0;
+        for (int item = 0; item < 8 && pos < bytes; item++) {
+            int best = 0, best_disp = 0;
+            for (int disp = 2; disp <= 4096 && disp <= pos; disp++) {
+                int n = 0;
+                while (n < 18 && pos + n < bytes && in[pos + n] == in[pos + n - disp]) {
+                    n++;
+                }
+                if (n > best) {
+                    best = n;
+                    best_disp = disp;
+                }
+            }
+            if (best >= 3) {
+                out[flags] |= 0x80 >> item;
+                out[length++] = ((best - 3) << 4) | ((best_disp - 1) >> 8);
+                out[length++] = (best_disp - 1) & 0xff;
+                pos += best;
+            } else {
+                out[length++] = in[pos++];
+            }
+        }
+    }
+    while (length & 3) {
+        out[length++] = 0;
+    }
+    return length;
+}
+
+/* pack in the BIOS run length format: a flag byte with the top bit set is
+ * a run of 3 to 130 of the next byte, otherwise 1 to 128 bytes as is */
+int rl_pack(const unsigned char* in, int bytes, unsigned char* out) {
+    int length = pack_header(out, ASSET_RL, bytes);
+    int pos = 0;
+    while (pos < bytes) {
+        int run = 1;
+        while (run < 130 && pos + run < bytes && in[pos + run] == in[pos]) {
+            run++;
+        }
+        if (run >= 3) {
+            out[length++] = 0x80 | (run - 3);
+            out[length++] = in[pos];
+            pos += run;
+            continue;
+        }
+
+        /* copy bytes as is up to the next run of 3 */
+        int start = pos;
+        while (pos < bytes && pos - start < 128 &&
+                !(pos + 2 < bytes && in[pos] == in[pos + 1] && in[pos] == in[pos + 2])) {
+            pos++;
+        }
+        out[length++] = pos - start - 1;
+        memcpy(&out[length], &in[start], pos - start);
+        length += pos - start;
+    }
+    while (length & 3) {
+        out[length++] = 0;
+    }
+    return length;
+}
+
+/* unpack either format like the BIOS does, returning the unpacked size */
+int asset_unpack(const unsigned char* in, unsigned char* out) {
+    int bytes = in[1] | (in[2] << 8) | (in[3] << 16);
+    int pos = 0;
+    in += 4;
+    if ((in[-4] & 0xf0) == ASSET_LZ77) {
+        while (pos < bytes) {
+            int flags = *in++;
+            for (int item = 0; item < 8 && pos < bytes; item++, flags <<= 1) {
+                if (flags & 0x80) {
+                    int n = (in[0] >> 4) + 3;
+                    int disp = (((in[0] & 15) << 8) | in[1]) + 1;
+                    in += 2;
+                    while (n-- && pos < bytes) {
+                        out[pos] = out[pos - disp];
+                        pos++;
+                    }
+                } else {
+                    out[pos++] = *in++;
+                }
+            }
+        }
+    } else {
+        while (pos < bytes) {
+            int flag = *in++;
+            if (flag & 0x80) {
+                int n = (flag & 0x7f) + 3;
+                memset(&out[pos], *in++, n);
+                pos += n;
+            } else {
+                int n = flag + 1;
+                memcpy(&out[pos], in, n);
+                in += n;
+                pos += n;
+            }
+        }
+    }
+    return bytes;
+}
+
+/* the host time to unpack some data, in microseconds */
+double unpack_time(const unsigned char* packed, int bytes) {
+    unsigned char* out = malloc(bytes);
+    int runs = 200;
+    clock_t start = clock();
+    for (int i = 0; i < runs; i++) {
+        asset_unpack(packed, out);
+    }
+    double us = (double) (clock() - start) * 1000000.0 / CLOCKS_PER_SEC / runs;
+    free(out);
+    return us;
+}
+
+/* pack some tiles in each format, check they unpack to the same bytes,
+ * and write the one picked as a blob - the header says how it is stored
+ * and its unpacked size */
+void emit_tiles(const char* symbol, const char* file, const unsigned char* data, int bytes,
+        int compress) {
+    unsigned char* packed[2];
+    int sizes[2];
+    const int types[2] = { ASSET_LZ77, ASSET_RL };
+    const char* names[2] = { "lz77", "rl" };
+    unsigned char* check = malloc(bytes + 1);
+    int best = -1;
+
+    packed[0] = malloc(bytes * 9 / 8 + 16);
+    packed[1] = malloc(bytes * 9 / 8 + 16);
+    sizes[0] = lz77_pack(data, bytes, packed[0]);
+    sizes[1] = rl_pack(data, bytes, packed[1]);
+    for (int i = 0; i < 2; i++) {
+        if (asset_unpack(packed[i], check) != bytes || memcmp(check, data, bytes)) {
+            fprintf(stderr, "assetconv: %s: %s does not unpack to the same data\n",
+                    symbol, names[i]);
+            exit(1);
+        }
+        printf("%s: %s %d bytes to %d (%d%%), unpacks in %.1f us on the host\n", symbol,
+                names[i], bytes, sizes[i], sizes[i] * 100 / bytes, unpack_time(packed[i], bytes));
+        if (compress == types[i] || (compress == ASSET_AUTO &&
+                sizes[i] <= bytes - bytes / 8 && (best < 0 || sizes[i] < sizes[best]))) {
+            best = i;
+        }
+    }
+
+    if (best < 0) {
+        write_blob(file, data, bytes);
+        emit_blob(symbol, file, "unsigned char", bytes);
+        fprintf(header, "#define %s_format ASSET_RAW\n", symbol);
+        printf("%s: stored raw\n", symbol);
+    } else {
+        write_blob(file, packed[best], sizes[best]);
+        emit_blob(symbol, file, "unsigned char", bytes);
+        fprintf(header, "#define %s_format ASSET_%s\n", symbol, best ? "RL" : "LZ77");
+        printf("%s: stored as %s\n", symbol, names[best]);
+    }
+
+    free(packed[0]);
+    free(packed[1]);
+    free(check);
+}
+
+/* 8bpp sprites first, then bigger sprites, then manifest order */
+int sprite_compare(const void* a, const void* b) {
+    const struct Sprite* sa = a;
+    const struct Sprite* sb = b;
+    if (sa->bpp != sb->bpp) {
+        return sb->bpp - sa->bpp;
+    }
+    int area = sb->width * sb->height - sa->width * sa->height;
+    return area ? area : sa->order - sb->order;
+}
+
+/* pick the banks of a 4bpp sheet, biggest sprites first, leaving the ones
+ * that don't fit 8bpp, then lay the sprites out one after another with no
+ * gaps - the 8bpp ones first, so each starts on an even tile index */
+void sheet_pack(struct Sheet* sheet) {
+    qsort(sheet->sprites, sheet->count, sizeof(struct Sprite), sprite_compare);
+    for (int i = 0; i < sheet->count; i++) {
+        sheet->sprites[i].bank = -1;
+    }
+    for (int i = 0; i < sheet->count && sheet->bpp == 4; i++) {
+        struct Sprite* s = &sheet->sprites[i];
+        s->bank = sheet_bank(sheet, s);
+        if (s->bank < 0) {
+            s->bpp = 8;
+        }
+    }
+    qsort(sheet->sprites, sheet->count, sizeof(struct Sprite), sprite_compare);
+
+    /* the 8bpp sprites share the palette with the banks, and reuse their
+     * colors where they can */
+    if (sheet->bpp == 4) {
+        for (int b = 0; b < sheet->bank_count; b++) {
+            memcpy(&sheet->palette.colors[b * BANK_SIZE], sheet->banks[b].colors,
+                    BANK_SIZE * 2);
+        }
+        if (sheet->bank_count) {
+            sheet->palette.count = sheet->bank_count * BANK_SIZE;
+        }
+    }
+
+    for (int i = 0; i < sheet->count; i++) {
+        struct Sprite* s = &sheet->sprites[i];
+        s->tile = sheet->bytes / 32;
+        struct Palette* palette = &sheet->palette;
+        if (s->bpp == 4) {
+            palette = &sheet->banks[s->bank];
+        } else {
+            s->bank = 0;
+        }
+        int approximated = palette->approximated;
+        sheet_add_tiles(sheet, s->bpp, palette, &s->image, s->x, s->y, s->w, s->h,
+                s->width, s->height);
+        if (palette->approximated != approximated) {
+            fprintf(stderr, "assetconv: %s: the palette has no room for the colors of %s\n",
+                    sheet->name, s->name);
+            exit(1);
+        }
+        if (s->bpp == 8) {
+            sheet->tiles_8bpp = sheet->bytes / 32;
+        }
+    }
+    for (int i = 0; i < sheet->count; i++) {
+        free(sheet->sprites[i].image.pixels);
+    }
+}
+
+/* write an enum of the sprites' tile indices or palette banks, the
+ * prefix and the name in capitals */
+void emit_enum(struct Sheet* sheet, const char* type, const char* prefix, int banks) {
+    fprintf(header, "enum %s%s {\n", sheet->name, type);
+    for (int i = 0; i < sheet->count; i++) {
+        struct Sprite* s = &sheet->sprites[i];
+        char name[128];
+        int j;
+        for (j = 0; s->name[j]; j++) {
+            name[j] = (s->name[j] >= 'a' && s->name[j] <= 'z') ? s->name[j] - 32 : s->name[j];
+        }
+        name[j] = 0;
+        if (banks && s->bpp == 8) {
+            fprintf(header, "    %s_%s = %d, /* 8bpp */\n", prefix, name, s->bank);
+        } else if (banks) {
+            fprintf(header, "    %s_%s = %d,\n", prefix, name, s->bank);
+        } else {
+            fprintf(header, "    %s_%s = %d, /* %dx%d */\n", prefix, name, s->tile,
+                    s->width, s->height);
+        }
+    }
+    fprintf(header, "};\n");
+}
+
+/* write out a finished sheet or background */
+void sheet_finish(struct Sheet* sheet) {
+    if (!sheet->name[0]) {
+        return;
+    }
+    char file[256], symbol[256];
+
+    fprintf(header, "\n/* %s */\n", sheet->name);
+    if (sheet->width) {
+        fprintf(header, "#define %s_width %d\n", sheet->name, sheet->width);
+        fprintf(header, "#define %s_height %d\n", sheet->name, sheet->height);
+    }
+    if (sheet->font) {
+        fprintf(header, "#define %s_first %d\n", sheet->name, ' ');
+        fprintf(header, "#define %s_glyphs %d\n", sheet->name, sheet->bytes / 32);
+    }
+    if (sheet->count) {
+        sheet_pack(sheet);
+        fprintf(header, "#define %s_8bpp_tiles %d\n", sheet->name, sheet->tiles_8bpp);
+        emit_enum(sheet, "Tiles", "TILE", 0);
+        if (sheet->bpp == 4) {
+            emit_enum(sheet, "Palettes", "PAL", 1);
+        }
+    }
+
+    snprintf(file, sizeof(file), "%s.img.bin", sheet->name);
+    snprintf(symbol, sizeof(symbol), "%s_data", sheet->name);
+    emit_tiles(symbol, file, sheet->data, sheet->bytes, sheet->compress);
+
+    /* a 4bpp sheet's palette is its banks one after another, then the
+     * colors of any 8bpp sprites */
+    unsigned short colors[PALETTE_SIZE];
+    int palette_bytes = sizeof(sheet->palette.colors);
+    int approximated = sheet->palette.approximated;
+    memcpy(colors, sheet->palette.colors, sizeof(colors));
+    if (sheet->font) {
+        palette_bytes = BANK_SIZE * 2;
+    } else if (sheet->bpp == 4) {
+        /* a whole number of words, the loader copies it with DMA */
+        palette_bytes = ((sheet->palette.count + 1) & ~1) * 2;
+    }
+
+    snprintf(file, sizeof(file), "%s.pal.bin", sheet->name);
+    snprintf(symbol, sizeof(symbol), "%s_palette", sheet->name);
+    write_blob(file, colors, palette_bytes);
+    emit_blob(symbol, file, "unsigned short", palette_bytes);
+
+    if (sheet->font) {
+        printf("%s: %d glyphs, %d bytes of 4bpp tiles, %d colors\n", sheet->name,
+                sheet->bytes / 32, sheet->bytes, sheet->palette.count);
+    } else if (sheet->bpp == 4) {
+        printf("%s: %d sprites, %d bytes of tiles, %d tile units 8bpp, %d palette banks, "
+                "%d colors\n", sheet->name, sheet->count, sheet->bytes, sheet->tiles_8bpp,
+                sheet->bank_count, sheet->palette.count);
+    } else if (sheet->tiles) {
+        /* a char block is 16K, 256 tiles at 8bpp */
+        printf("%s: %d tiles, %d after removing repeats and flips, %d%% of a char block "
+                "down to %d%%, %d colors\n", sheet->name, sheet->tiles, sheet->bytes / 64,
+                sheet->tiles * 100 / 256, sheet->bytes / 64 * 100 / 256, sheet->palette.count);
+    } else {
+        printf("%s: %d sprites, %d bytes of tiles, %d colors\n", sheet->name,
+                sheet->count, sheet->bytes, sheet->palette.count);
+    }
+    if (approximated) {
+        printf("%s: %d pixels given the nearest color, the palette is full\n",
+                sheet->name, approximated);
+    }
+
+    free(sheet->data);
+    memset(sheet, 0, sizeof(*sheet));
+}
+
+/* read the array of a tile editor's map header */
+unsigned short* map_load(const char* file, int* count) {
+    FILE* f = fopen(file, "r");
+    if (!f) {
+        perror(file);
+        return NULL;
+    }
+    unsigned short* entries = NULL;
+    *count = 0;
+    int c;
+    while ((c = fgetc(f)) != EOF && c != '{') {
+    }
+    char word[32];
+    while (fscanf(f, " %31[^,} \t\r\n]", word) == 1) {
+        entries = realloc(entries, (*count + 1) * sizeof(unsigned short));
+        entries[(*count)++] = strtol(word, NULL, 0);
+        if (fscanf(f, " %1[,]", word) != 1) {
+            break;
+        }
+    }
+    fclose(f);
+    return entries;
+}
+
+/* remap a map through the background's deduplicated tiles, and write it
+ * as run length encoded rows from first_row going up the screen */
+int map_write(const struct Sheet* sheet, const char* name, const char* file, int first_row) {
+    int count;
+    unsigned short* entries = map_load(file, &count);
+    if (!entries || count == 0 || count % 32) {
+        fprintf(stderr, "assetconv: %s: not a map 32 entries wide\n", file);
+        return 0;
+    }
+    int rows = count / 32;
+
+    unsigned short* runs = malloc(count * 2 * sizeof(unsigned short));
+    int length = 0;
+    for (int r = 0; r < rows; r++) {
+        unsigned short* row = &entries[((first_row - r) % rows + rows) % rows * 32];
+        for (int x = 0; x < 32; x++) {
+            int tile = row[x] & 0x03ff;
+            if (tile >= sheet->tiles) {
+                fprintf(stderr, "assetconv: %s: tile %d is past %s\n", file, tile, sheet->name);
+                return 0;
+            }
+            /* flips compose, so the entry's own flip is xored on */
+            row[x] = (row[x] & ~0x03ff) ^ sheet->remap[tile];
+        }
+        for (int x = 0; x < 32;) {
+            int run = 1;
+            while (x + run < 32 && row[x + run] == row[x]) {
+                run++;
+            }
+            runs[length++] = run;
+            runs[length++] = row[x];
+            x += run;
+        }
+    }
+
+    char blob[256], symbol[256];
+    snprintf(blob, sizeof(blob), "%s.map.bin", name);
+    snprintf(symbol, sizeof(symbol), "%s_data", name);
+    fprintf(header, "\n/* %s, a map of %s */\n", name, sheet->name);
+    fprintf(header, "#define %s_rows %d\n", name, rows);
+    write_blob(blob, runs, length * sizeof(unsigned short));
+    emit_blob(symbol, blob, "unsigned short", length * sizeof(unsigned short));
+    printf("%s: %d rows, %d bytes of runs\n", name, rows, (int) (length * sizeof(unsigned short)));
+
+    free(runs);
+    free(entries);
+    return 1;
+}
+
+/* start a new sheet, index 0 is magenta like png2gba's transparent color */
+void sheet_start(struct Sheet* sheet, const char* name, int black_transparent, int bpp) {
+    sheet_finish(sheet);
+    sheet->bpp = bpp;
+    sheet->compress = compress_mode;
+    sheet->palette.size = PALETTE_SIZE;
+    sheet->palette.black_transparent = black_transparent;
+    snprintf(sheet->name, sizeof(sheet->name), "%s", name);
+    sheet->palette.colors[0] = 0x7c1f;
+    sheet->palette.count = 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: assetconv <manifest> <output directory>\n");
+        return 1;
+    }
+    out_dir = argv[2];
+
+    FILE* manifest = fopen(argv[1], "r");
+    if (!manifest) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/assets.h", out_dir);
+    header = fopen(path, "w");
+    snprintf(path, sizeof(path), "%s/assets.s", out_dir);
+    assembly = fopen(path, "w");
+    if (!header || !assembly) {
+        perror(path);
+        return 1;
+    }
+    fprintf(header, "/* assets.h\n * generated by assetconv from %s */\n", argv[1]);
+    fprintf(header, "\n/* how tile data is stored, the BIOS header types, and _bytes is the\n"
+            " * unpacked size */\n");
+    fprintf(header, "#define ASSET_RAW 0x%02x\n#define ASSET_LZ77 0x%02x\n#define ASSET_RL 0x%02x\n",
+            ASSET_RAW, ASSET_LZ77, ASSET_RL);
+    fprintf(assembly, "@ assets.s\n@ generated by assetconv from %s\n\n.section .rodata\n", argv[1]);
+
+    struct Sheet sheet;
+    memset(&sheet, 0, sizeof(sheet));
+
+    char line[512];
+    int line_num = 0;
+    int group = 0, groups = 0;
+    int row;
+    while (fgets(line, sizeof(line), manifest)) {
+        line_num++;
+        char a[128], b[256], c[256];
+        int x, y, w, h;
+        int n = sscanf(line, "%127s %255s %255s", a, b, c);
+        if (n <= 0 || a[0] == '#') {
+            continue;
+        }
+
+        if (strcmp(a, "sheet") == 0 && (n == 2 || (n == 3 && (!strcmp(c, "4") || !strcmp(c, "8"))))) {
+            sheet_start(&sheet, b, 1, n == 3 ? atoi(c) : 8);
+        } else if (strcmp(a, "group") == 0 && n == 1 && sheet.name[0]) {
+            group = ++groups;
+        } else if (strcmp(a, "end") == 0 && n == 1) {
+            group = 0;
+        } else if (strcmp(a, "background") == 0 && n == 3) {
+            struct Image image;
+            sheet_start(&sheet, b, 0, 8);
+            if (!image_load(&image, c)) {
+                return 1;
+            }
+
+            /* backgrounds are cut into 8x8 tiles row by row, a partial
+             * row of tiles at the bottom is padded with transparency */
+            sheet.width = (image.width + 7) & ~7;
+            sheet.height = (image.height + 7) & ~7;
+            if (sheet.width / 8 * sheet.height / 8 > MAX_TILES) {
+                fprintf(stderr, "assetconv: %s: more than %d tiles\n", c, MAX_TILES);
+                return 1;
+            }
+            for (int ty = 0; ty < image.height; ty += 8) {
+                for (int tx = 0; tx < image.width; tx += 8) {
+                    sheet_add_tiles(&sheet, sheet.bpp, &sheet.palette, &image, tx, ty, 8, 8, 8, 8);
+                    sheet_dedup_tile(&sheet);
+                }
+            }
+            free(image.pixels);
+        } else if (strcmp(a, "font") == 0 && n == 3) {
+            struct Image image;
+            sheet_start(&sheet, b, 1, 4);
+            if (!image_load(&image, c)) {
+                return 1;
+            }
+
+            /* glyphs are read across then down, the first one is a space */
+            sheet.font = 1;
+            sheet.palette.size = BANK_SIZE;
+            for (int ty = 0; ty + 8 <= image.height; ty += 8) {
+                for (int tx = 0; tx + 8 <= image.width; tx += 8) {
+                    sheet_add_tiles(&sheet, sheet.bpp, &sheet.palette, &image, tx, ty, 8, 8, 8, 8);
+                }
+            }
+            free(image.pixels);
+            sheet_finish(&sheet);
+        } else if (strcmp(a, "compress") == 0 && n == 2) {
+            if (strcmp(b, "auto") == 0) {
+                compress_mode = ASSET_AUTO;
+            } else if (strcmp(b, "lz77") == 0) {
+                compress_mode = ASSET_LZ77;
+            } else if (strcmp(b, "rl") == 0) {
+                compress_mode = ASSET_RL;
+            } else if (strcmp(b, "raw") == 0) {
+                compress_mode = ASSET_RAW;
+            } else {
+                fprintf(stderr, "assetconv: %s:%d: unknown compression %s\n", argv[1], line_num, b);
+                return 1;
+            }
+        } else if (strcmp(a, "map") == 0 && sheet.tiles &&
+                sscanf(line, "%*s %*s %*s %d", &row) == 1) {
+            if (!map_write(&sheet, b, c, row)) {
+                return 1;
+            }
+        } else if (sheet.name[0] && !sheet.tiles && sheet.count < MAX_SPRITES) {
+            struct Sprite* s = &sheet.sprites[sheet.count];
+            if (!image_load(&s->image, b)) {
+                return 1;
+            }
+            n = sscanf(line, "%*s %*s %d %d %d %d", &x, &y, &w, &h);
+            if (n != 4) {
+                x = 0;
+                y = 0;
+                w = s->image.width;
+                h = s->image.height;
+            }
+            snprintf(s->name, sizeof(s->name), "%s", a);
+            s->x = x;
+            s->y = y;
+            s->w = w;
+            s->h = h;
+            s->order = sheet.count++;
+            s->group = group;
+            s->bpp = sheet.bpp;
+
+            /* the smallest hardware size it fits in */
+            s->width = 0;
+            for (int i = 0; i < 12 && !s->width; i++) {
+                if (w <= obj_sizes[i][0] && h <= obj_sizes[i][1]) {
+                    s->width = obj_sizes[i][0];
+                    s->height = obj_sizes[i][1];
+                }
+            }
+            if (!s->width) {
+                fprintf(stderr, "assetconv: %s:%d: %s is bigger than 64x64\n",
+                        argv[1], line_num, a);
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "assetconv: %s:%d: bad line\n", argv[1], line_num);
+            return 1;
+        }
+    }
+    sheet_finish(&sheet);
+
+    fclose(manifest);
+    fclose(header);
+    fclose(assembly);
+    return 0;
+}
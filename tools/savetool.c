@@ -0,0 +1,314 @@
+/*
+ * savetool.c
+ * host tool which reads and writes the game's high score save the way the
+ * game does, on the .sav file emulators keep the cartridge SRAM or flash in
+ *
+ * a blank, old or damaged save is replaced by the default table, and a
+ * score given on the command line is put in its place
+ *
+ * for SRAM, like the game, the newer of the two copies is loaded and a
+ * save goes over the older one - only the bytes which changed are written
+ * back, entries before the header and the generation byte last, and the
+ * count of them is printed
+ *
+ * for flash (-f) the journal code the game uses runs on an emulated chip
+ * kept in the file - erases and programs take the chip's worst case
+ * times, and the job gets the idle part of each emulated frame, so the
+ * tool prints how many frames and milliseconds a save takes - -c stops
+ * the job after some steps, like the power going off, to check the last
+ * good record is what comes back next time
+ *
+ * -t runs that check on every step of a save instead, with the journal
+ * filled to either side of its sector ends, and exits non zero if any cut
+ * brings back the wrong table
+ *
+ * build: gcc -O2 -o savetool tools/savetool.c
+ * usage: savetool [-f] [-c steps] <file.sav> [score stage [name]]
+ *        savetool -t
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../save.h"
+
+/* the size of the SRAM and flash, emulators want all of it in the file */
+#define SRAM_SIZE 0x8000
+#define FLASH_SIZE 0x10000
+
+/* the worst case times of the 64K flash chips, in microseconds */
+#define ERASE_US 25000
+#define PROGRAM_US 20
+
+/* a frame, the part of it the game spends waiting for vblank, and the
+ * time one step of the job takes the CPU */
+#define FRAME_US 16743
+#define IDLE_US 8000
+#define STEP_US 5
+
+/* the save memory */
+unsigned char memory[FLASH_SIZE];
+
+/* the emulated time, and when the chip's erase or program is done */
+long flash_clock = 0;
+long flash_done = 0;
+
+/* the number of erases and programs */
+int flash_erases = 0;
+int flash_programs = 0;
+
+/* set to keep flash_save from printing */
+int quiet = 0;
+
+unsigned char sram_read(int address) {
+    return memory[address];
+}
+
+/* while busy the chip answers every read with bit 7 of the data flipped */
+unsigned char flash_read(int address) {
+    if (flash_clock < flash_done) {
+        return memory[address] ^ 0x80;
+    }
+    return memory[address];
+}
+
+void flash_erase(int sector) {
+    if (flash_clock < flash_done) {
+        fprintf(stderr, "erase while the flash is busy\n");
+        exit(1);
+    }
+    memset(memory + sector * FLASH_SECTOR, 0xff, FLASH_SECTOR);
+    flash_done = flash_clock + ERASE_US;
+    flash_erases++;
+}
+
+/* programming can only clear bits */
+void flash_program(int address, unsigned char value) {
+    if (flash_clock < flash_done) {
+        fprintf(stderr, "program while the flash is busy\n");
+        exit(1);
+    }
+    memory[address] &= value;
+    flash_done = flash_clock + PROGRAM_US;
+    flash_programs++;
+}
+
+/* save the table to the flash a frame at a time, or until the steps run
+ * out - returns 0 if it was cut off */
+int flash_save(struct Journal* journal, const struct ScoreTable* scores, int steps) {
+    int frames = 0;
+    long start = flash_clock;
+    journal->pending = 1;
+    for (;;) {
+        frames++;
+        for (long idle = 0; idle < IDLE_US; idle += STEP_US) {
+            if (steps-- == 0) {
+                if (!quiet) {
+                    printf("cut off after %d frames\n", frames);
+                }
+                return 0;
+            }
+            if (!journal_step(journal, scores)) {
+                if (quiet) {
+                    return 1;
+                }
+                printf("saved to slot %d in %d frames, %.1f ms, %d erases, %d programs\n",
+                        journal->newest, frames, (flash_clock - start) / 1000.0,
+                        flash_erases, flash_programs);
+                return 1;
+            }
+            flash_clock += STEP_US;
+        }
+        flash_clock += FRAME_US - IDLE_US;
+    }
+}
+
+/* whether two tables are the same */
+int same_table(const struct ScoreTable* a, const struct ScoreTable* b) {
+    return !memcmp(a, b, sizeof(*a));
+}
+
+/* the power cut test - the journal is filled with some records, then a
+ * save is cut off after every number of steps up to the whole of it, and
+ * after each the table that comes back must be the last one saved, or the
+ * new one if its record got written, and the one after must still save */
+int power_cut_test(void) {
+    static const int fills[] = {
+        1, 2, RECORD_SLOTS - 1, RECORD_SLOTS, RECORD_SLOTS + 1,
+        RECORD_SLOTS * JOURNAL_SECTORS - 1, RECORD_SLOTS * JOURNAL_SECTORS,
+        RECORD_SLOTS * JOURNAL_SECTORS + 1
+    };
+    static unsigned char filled[FLASH_SECTOR * JOURNAL_SECTORS];
+    struct Journal journal;
+    struct ScoreTable saved, cut, after, found;
+    int cuts = 0;
+    quiet = 1;
+    for (int f = 0; f < (int) (sizeof(fills) / sizeof(fills[0])); f++) {
+        memset(memory, 0xff, sizeof(memory));
+        flash_clock = flash_done = 0;
+        journal_recover(&journal, &saved);
+        save_defaults(&saved);
+        for (int i = 0; i < fills[f]; i++) {
+            save_insert(&saved, 100000 + i, "TST", 1);
+            flash_save(&journal, &saved, -1);
+        }
+        memcpy(filled, memory, sizeof(filled));
+        cut = saved;
+        save_insert(&cut, 200000, "CUT", 2);
+        after = cut;
+        save_insert(&after, 300000, "AFT", 3);
+
+        for (int steps = 0; ; steps++) {
+            /* power on, save until the power goes, and power on again */
+            memcpy(memory, filled, sizeof(filled));
+            flash_clock = flash_done = 0;
+            if (!journal_recover(&journal, &found) || !same_table(&found, &saved)) {
+                printf("%d records: the filled journal doesn't load\n", fills[f]);
+                return 1;
+            }
+            int done = flash_save(&journal, &cut, steps);
+            flash_clock = flash_done = 0;
+            cuts++;
+            if (!journal_recover(&journal, &found) ||
+                    !(same_table(&found, &cut) || (!done && same_table(&found, &saved)))) {
+                printf("%d records, cut after %d steps: the wrong table came back\n",
+                        fills[f], steps);
+                return 1;
+            }
+            if (!flash_save(&journal, &after, -1) ||
+                    !journal_recover(&journal, &found) || !same_table(&found, &after)) {
+                printf("%d records, cut after %d steps: the next save was lost\n",
+                        fills[f], steps);
+                return 1;
+            }
+            if (done) {
+                break;
+            }
+        }
+    }
+    printf("%d power cuts, the last good record came back from all of them\n", cuts);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 2 && !strcmp(argv[1], "-t")) {
+        return power_cut_test();
+    }
+    int flash = 0;
+    int steps = -1;
+    int arg = 1;
+    while (arg < argc && argv[arg][0] == '-') {
+        if (!strcmp(argv[arg], "-f")) {
+            flash = 1;
+            arg++;
+        } else if (!strcmp(argv[arg], "-c") && arg + 1 < argc) {
+            steps = atoi(argv[arg + 1]);
+            arg += 2;
+        } else {
+            break;
+        }
+    }
+    int left = argc - arg;
+    if (left != 1 && left != 3 && left != 4) {
+        fprintf(stderr, "usage: %s [-f] [-c steps] <file.sav> [score stage [name]]\n"
+                "       %s -t\n", argv[0], argv[0]);
+        return 1;
+    }
+    const char* path = argv[arg];
+    int size = flash ? FLASH_SIZE : SRAM_SIZE;
+
+    /* the file as it is, blank memory reads as 0xff, and so does any of
+     * it past the end of a short file */
+    memset(memory, 0xff, sizeof(memory));
+    FILE* f = fopen(path, "rb");
+    if (f) {
+        if (fread(memory, 1, size, f) < (size_t) size && ferror(f)) {
+            fprintf(stderr, "%s: can't read\n", path);
+            return 1;
+        }
+        fclose(f);
+    }
+
+    struct ScoreTable scores;
+    struct Journal journal;
+    unsigned char generation = 0;
+    int copy = 0;
+    int valid;
+    if (flash) {
+        valid = journal_recover(&journal, &scores);
+        if (valid) {
+            printf("%s: record %u in slot %d, next goes in slot %d\n", path,
+                    journal.sequence, journal.newest, journal.next);
+        }
+    } else {
+        int newest = sram_recover(&scores, &generation);
+        valid = newest >= 0;
+        if (valid) {
+            printf("%s: generation %d in copy %d\n", path, generation, newest);
+            copy = newest ^ 1;
+        }
+    }
+    int changed = !valid;
+    if (!valid) {
+        printf("%s: no valid table, using the defaults\n", path);
+        save_defaults(&scores);
+    }
+
+    if (left >= 3) {
+        const char* name = left == 4 ? argv[arg + 3] : "YOU";
+        char padded[SCORE_NAME];
+        for (int j = 0; j < SCORE_NAME; j++) {
+            padded[j] = j < (int) strlen(name) ? name[j] : ' ';
+        }
+        int rank = save_insert(&scores, strtoul(argv[arg + 1], 0, 10), padded,
+                atoi(argv[arg + 2]));
+        if (rank < 0) {
+            printf("%s doesn't make the table\n", argv[arg + 1]);
+        } else {
+            printf("%s is number %d\n", argv[arg + 1], rank + 1);
+            changed = 1;
+        }
+    }
+
+    int written = 0;
+    if (flash) {
+        if (changed) {
+            flash_save(&journal, &scores, steps);
+            written = 1;
+        }
+    } else {
+        /* write back what changed over the older copy, in the game's order */
+        if (changed) {
+            const unsigned char* table = (const unsigned char*) &scores;
+            int header = sizeof(struct SaveHeader);
+            int base = copy * SRAM_COPY_BYTES;
+            for (int n = 0; n < (int) sizeof(scores); n++) {
+                int i = (n + header) % sizeof(scores);
+                if (memory[base + i] != table[i]) {
+                    memory[base + i] = table[i];
+                    written++;
+                }
+            }
+            memory[sram_generation(copy)] = ++generation;
+            written++;
+            printf("%d of %d bytes written to copy %d\n", written,
+                    (int) sizeof(scores) + 1, copy);
+        }
+    }
+
+    if (written) {
+        f = fopen(path, "wb");
+        if (!f || fwrite(memory, 1, size, f) != (size_t) size) {
+            fprintf(stderr, "%s: can't write\n", path);
+            return 1;
+        }
+        fclose(f);
+    }
+
+    for (int i = 0; i < SCORE_ENTRIES; i++) {
+        struct ScoreEntry* e = &scores.entries[i];
+        printf("%2d  %.3s  %8u  stage %d\n", i + 1, e->name, e->score, e->stage);
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+/*
+ * scanbench.c
+ * host tool which times the scanline table generators in scanline.h, the
+ * ones the game runs each frame of an effect to build the next frame's
+ * table while the current one plays
+ *
+ * each effect is played through at its length in the game, over and over,
+ * and the time a table takes is printed along with a checksum of the
+ * tables, which changes if the generator's output does
+ *
+ * build: gcc -O2 -o scanbench tools/scanbench.c
+ * usage: scanbench [runs]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../scanline.h"
+
+/* the effects and the frames the game plays them for */
+struct Effect {
+    const char* name;
+    int effect;
+    int frames;
+};
+
+const struct Effect effects[] = {
+    { "warp", SCANLINE_WARP, 60 },
+    { "stretch", SCANLINE_STRETCH, 30 },
+};
+
+int main(int argc, char** argv) {
+    int runs = argc > 1 ? atoi(argv[1]) : 20000;
+    if (runs <= 0) {
+        fprintf(stderr, "usage: %s [runs]\n", argv[0]);
+        return 1;
+    }
+
+    unsigned int table[SCANLINES + 1];
+    for (int e = 0; e < (int) (sizeof(effects) / sizeof(effects[0])); e++) {
+        const struct Effect* f = &effects[e];
+        unsigned int checksum = 0;
+        clock_t start = clock();
+        for (int run = 0; run < runs; run++) {
+            /* the scroll moves on like the stage does, with the map
+             * streamed in from a row above the screen */
+            int y = run & 0xff;
+            int bottom = ((y >> 3) + 31) * 8;
+            for (int left = f->frames; left > 0; left--) {
+                scanline_build(table, f->effect, 0, y, bottom, left, f->frames);
+                checksum = checksum * 31 + table[left];
+            }
+        }
+        double ns = (double) (clock() - start) * 1000000000.0 / CLOCKS_PER_SEC /
+            ((double) runs * f->frames);
+        printf("%-8s %7.1f ns a table, %5.2f ns a line, checksum %08x\n", f->name, ns,
+                ns / (SCANLINES + 1), checksum);
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * tilebench.c
+ * host tool which times the tile map lookups in tilemap.h, the general
+ * tile_lookup which wraps with loops and finds the screen block with
+ * compares and a multiply, against the power of two ones the game uses
+ * which wrap with a mask and find it with shifts
+ *
+ * each lookup is run over the same scattered screen coordinates and
+ * scrolls, and the time a lookup takes is printed with a checksum of the
+ * tiles found, which must match between the two ways
+ *
+ * build: gcc -O2 -o tilebench tools/tilebench.c
+ * usage: tilebench [runs]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../tilemap.h"
+
+/* the coordinates looked up each run */
+#define POINTS 4096
+
+/* a 64x64 map, the biggest regular background, each entry its index so
+ * a wrong lookup changes the checksum */
+unsigned short map[64 * 64];
+
+int xs[POINTS], ys[POINTS], xscrolls[POINTS], yscrolls[POINTS];
+
+/* the sizes of map there are lookups for */
+struct Size {
+    const char* name;
+    int w, h;
+};
+
+const struct Size sizes[] = {
+    { "32x32", 32, 32 },
+    { "64x32", 64, 32 },
+    { "32x64", 32, 64 },
+    { "64x64", 64, 64 },
+};
+
+/* the power of two lookup of a size, picked outside the timed loop */
+unsigned short lookup_pow2(int size, int x, int y, int xscroll, int yscroll) {
+    switch (size) {
+        case 0: return tile_lookup_32x32(x, y, xscroll, yscroll, map);
+        case 1: return tile_lookup_64x32(x, y, xscroll, yscroll, map);
+        case 2: return tile_lookup_32x64(x, y, xscroll, yscroll, map);
+        default: return tile_lookup_64x64(x, y, xscroll, yscroll, map);
+    }
+}
+
+/* the nanoseconds one lookup took, over runs of every point */
+double per_lookup(clock_t start, int runs, int lookups) {
+    return (double) (clock() - start) * 1000000000.0 / CLOCKS_PER_SEC /
+        ((double) runs * lookups);
+}
+
+int main(int argc, char** argv) {
+    int runs = argc > 1 ? atoi(argv[1]) : 2000;
+    if (runs <= 0) {
+        fprintf(stderr, "usage: %s [runs]\n", argv[0]);
+        return 1;
+    }
+
+    for (int i = 0; i < 64 * 64; i++) {
+        map[i] = i;
+    }
+
+    /* points on the screen, scrolled anywhere the registers can go */
+    srand(1);
+    for (int i = 0; i < POINTS; i++) {
+        xs[i] = rand() % 240;
+        ys[i] = rand() % 160;
+        xscrolls[i] = rand() % 1024 - 512;
+        yscrolls[i] = rand() % 1024 - 512;
+    }
+
+    int failed = 0;
+    for (int s = 0; s < (int) (sizeof(sizes) / sizeof(sizes[0])); s++) {
+        const struct Size* size = &sizes[s];
+        unsigned int multiply = 0;
+        clock_t start = clock();
+        for (int run = 0; run < runs; run++) {
+            for (int i = 0; i < POINTS; i++) {
+                multiply = multiply * 31 + tile_lookup(xs[i], ys[i], xscrolls[i], yscrolls[i],
+                        map, size->w, size->h);
+            }
+        }
+        double multiply_ns = per_lookup(start, runs, POINTS);
+
+        unsigned int pow2 = 0;
+        start = clock();
+        for (int run = 0; run < runs; run++) {
+            for (int i = 0; i < POINTS; i++) {
+                pow2 = pow2 * 31 + lookup_pow2(s, xs[i], ys[i], xscrolls[i], yscrolls[i]);
+            }
+        }
+        double pow2_ns = per_lookup(start, runs, POINTS);
+
+        printf("%s  multiply %5.2f ns  pow2 %5.2f ns a lookup, checksum %08x %08x%s\n",
+                size->name, multiply_ns, pow2_ns, multiply, pow2,
+                multiply == pow2 ? "" : "  DIFFERENT");
+        failed |= multiply != pow2;
+    }
+
+    /* a row of a 32x32 map a lookup at a time, against the row lookup */
+    unsigned short row[32];
+    unsigned int multiply = 0;
+    clock_t start = clock();
+    for (int run = 0; run < runs; run++) {
+        for (int i = 0; i < POINTS; i++) {
+            for (int j = 0; j < 32; j++) {
+                row[j] = tile_lookup(xs[i] + j * 8, ys[i], xscrolls[i], yscrolls[i], map, 32, 32);
+            }
+            multiply = multiply * 31 + row[i & 31];
+        }
+    }
+    double multiply_ns = per_lookup(start, runs, POINTS);
+
+    unsigned int pow2 = 0;
+    start = clock();
+    for (int run = 0; run < runs; run++) {
+        for (int i = 0; i < POINTS; i++) {
+            tile_row_32x32(xs[i], ys[i], xscrolls[i], yscrolls[i], map, row, 32);
+            pow2 = pow2 * 31 + row[i & 31];
+        }
+    }
+    double pow2_ns = per_lookup(start, runs, POINTS);
+
+    printf("row    multiply %5.2f ns  pow2 %5.2f ns a row, checksum %08x %08x%s\n",
+            multiply_ns, pow2_ns, multiply, pow2, multiply == pow2 ? "" : "  DIFFERENT");
+    failed |= multiply != pow2;
+    return failed;
+}